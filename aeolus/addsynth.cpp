@@ -246,6 +246,7 @@ Addsynth::Addsynth()
 void Addsynth::reset()
       {
       *_stopname = 0;
+      _hash      = 0;
       *_mnemonic = 0;
       *_copyrite = 0;
       *_comments = 0;
@@ -336,6 +337,8 @@ int Addsynth::load (const char* sdir)
             fprintf (stderr, "Can't open '%s' for reading\n", qPrintable(f.fileName()));
             return 1;
             }
+      _hash = qHash(f.readAll());
+      f.seek(0);
 
       f.read (d, 32);
       if (strcmp (d, "AEOLUS")) {
@@ -116,6 +116,7 @@ class Addsynth
 
       char       _pan;
       int32_t    _del;
+      uint32_t   _hash;       // hash of the stop file, keys the wave cache
       };
 
 
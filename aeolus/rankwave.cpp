@@ -16,26 +16,20 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <QtConcurrent/QtConcurrentMap>
+#include <QSaveFile>
 #include "rankwave.h"
 
 #define DEBUG
 
+// version of the .ae1 wave files; 2 adds the stop definition hash
+// and stores the release detune and instability of the pipes
+#define AE1_VERSION 2
+
 extern float exp2ap (float);
 
 
 Rngen   Pipewave::_rgen;
-float  *Pipewave::_arg = 0;
-float  *Pipewave::_att = 0;
-
-void Pipewave::initstatic(float fsamp)
-      {
-      if (_arg)
-            return;
-      int k = (int)(fsamp);
-      _arg  = new float [k];
-      k     = (int)(0.5f * fsamp);
-      _att  = new float [k];
-      }
 
 //---------------------------------------------------------
 //   play
@@ -183,7 +177,7 @@ void Pipewave::play()
 }
 
 
-void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
+void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe, Rngen& rgen, float *arg, float *att)
 {
     int    h, i, k, nc;
     float  f0, f1, f, m, t, v, v0;
@@ -197,7 +191,7 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
     _l0 = (int)(fsamp * m + 0.5);
     _l0 = (_l0 + PERIOD - 1) & ~(PERIOD - 1);
 
-    f1 = (fpipe + D->_n_off.vi (n) + D->_n_ran.vi (n) * (2 * _rgen.urand () - 1)) / fsamp;
+    f1 = (fpipe + D->_n_off.vi (n) + D->_n_ran.vi (n) * (2 * rgen.urand () - 1)) / fsamp;
     f0 = f1 * exp2ap (D->_n_atd.vi (n) / 1200.0f);
 
     for (h = N_HARM - 1; h >= 0; h--)
@@ -219,7 +213,8 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
 
     k = _l0 + _l1 + _k_s * (PERIOD + 4);
 
-    delete[] _p0;
+    if (!_mapped) delete[] _p0;
+    _mapped = false;
     _p0 = new float [k];
     _p1 = _p0 + _l0;
     _p2 = _p1 + _l1;
@@ -234,14 +229,14 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
     k = (int)(fsamp * D->_n_att.vi (n) + 0.5);
     for (i = 0; i <= _l0; i++)
     {
-        _arg [i] = t - floorf (t + 0.5);
+        arg [i] = t - floorf (t + 0.5);
 	t += (i < k) ? (((k - i) * f0 + i * f1) / k) : f1;
     }
 
     for (i = 1; i < _l1; i++)
     {
-	t = _arg [_l0]+ (float) i * nc / _l1;
-        _arg [i + _l0] = t - floorf (t + 0.5);
+	t = arg [_l0]+ (float) i * nc / _l1;
+        arg [i + _l0] = t - floorf (t + 0.5);
     }
 
     v0 = exp2ap (0.1661 * D->_n_vol.vi (n));
@@ -251,16 +246,16 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
         v = D->_h_lev.vi (h, n);
         if (v < -80.0) continue;
 
-        v = v0 * exp2ap (0.1661 * (v + D->_h_ran.vi (h, n) * (2 * _rgen.urand () - 1)));
+        v = v0 * exp2ap (0.1661 * (v + D->_h_ran.vi (h, n) * (2 * rgen.urand () - 1)));
         k = (int)(fsamp * D->_h_att.vi (h, n) + 0.5);
-        attgain (k, D->_h_atp.vi (h, n));
+        attgain (k, D->_h_atp.vi (h, n), att);
 
         for (i = 0; i < _l0 + _l1; i++)
         {
-	    t = _arg [i] * (h + 1);
+	    t = arg [i] * (h + 1);
             t -= floorf (t);
             m = v * sinf (2 * M_PI * t);
-            if (i < k) m *= _att [i];
+            if (i < k) m *= att [i];
             _p0 [i] += m;
         }
     }
@@ -311,7 +306,7 @@ void Pipewave::looplen (float f, float fsamp, int lmax, int *aa, int *bb)
 }
 
 
-void Pipewave::attgain (int n, float p)
+void Pipewave::attgain (int n, float p, float *att)
 {
     int    i, j, k;
     float  d, m, w, x, y, z;
@@ -331,14 +326,14 @@ void Pipewave::attgain (int n, float p)
         while (j < k)
 	{
             m = (double) j / n;
-            _att [j++] = (1.0 - m) * z + m;
+            att [j++] = (1.0 - m) * z + m;
             z += d;
 	}
     }
 }
 
 
-void Pipewave::save (FILE *F)
+void Pipewave::save (QIODevice *F)
 {
     int  k;
     union
@@ -353,19 +348,24 @@ void Pipewave::save (FILE *F)
     d.i16 [4] = _k_s;
     d.i16 [5] = _k_r;
     d.flt [3] = _m_r;
-    d.i32 [4] = 0;
-    d.i32 [5] = 0;
+    d.flt [4] = _d_r;
+    d.flt [5] = _d_p;
     d.i32 [6] = 0;
     d.i32 [7] = 0;
-    fwrite (&d, 1, 32, F);
+    F->write ((const char *) &d, 32);
     k = _l0 +_l1 + _k_s * (PERIOD + 4);
-    fwrite (_p0, k, sizeof (float), F);
+    F->write ((const char *) _p0, k * sizeof (float));
 }
 
 
-void Pipewave::load (FILE *F)
+//---------------------------------------------------------
+//   load
+//    point the pipe at its wave in the mapped file at p
+//    and advance p; return false if the file is too short
+//---------------------------------------------------------
+
+bool Pipewave::load (const uchar*& p, const uchar* end)
 {
-    int  k;
     union
     {
         int16_t i16 [16];
@@ -373,24 +373,31 @@ void Pipewave::load (FILE *F)
 	float   flt [8];
     } d;
 
-    fread (&d, 1, 32, F);
+    if (end - p < 32) return false;
+    memcpy (&d, p, 32);
+    int k = d.i32 [0] + d.i32 [1] + d.i16 [4] * (PERIOD + 4);
+    if (d.i32 [0] < 0 || d.i32 [1] <= 0 || k <= 0 || (end - p - 32) / (int) sizeof (float) < k) return false;
+
     _l0  = d.i32 [0];
     _l1  = d.i32 [1];
     _k_s = d.i16 [4];
     _k_r = d.i16 [5];
     _m_r = d.flt [3];
-    k = _l0 +_l1 + _k_s * (PERIOD + 4);
-    delete[] _p0;
-    _p0 = new float [k];
+    _d_r = d.flt [4];
+    _d_p = d.flt [5];
+    if (!_mapped) delete[] _p0;
+    _mapped = true;
+    _p0 = (float *)(p + 32);
     _p1 = _p0 + _l0;
     _p2 = _p1 + _l1;
-    fread (_p0, k, sizeof (float), F);
+    p += 32 + k * sizeof (float);
+    return true;
 }
 
 
 
 
-Rankwave::Rankwave (int n0, int n1) : _n0 (n0), _n1 (n1), _list (0), _modif (false)
+Rankwave::Rankwave (int n0, int n1) : _n0 (n0), _n1 (n1), _list (0), _modif (false), _file (0)
 {
     _pipes = new Pipewave [n1 - n0 + 1];
 }
@@ -399,18 +406,39 @@ Rankwave::Rankwave (int n0, int n1) : _n0 (n0), _n1 (n1), _list (0), _modif (fal
 Rankwave::~Rankwave (void)
 {
     delete[] _pipes;
+    delete _file;
 }
 
+//---------------------------------------------------------
+//   gen_waves
+//    the pipes are independent: each one gets its own
+//    random generator, seeded from the shared one, and
+//    its own scratch buffers, and they are generated
+//    concurrently
+//---------------------------------------------------------
 
 void Rankwave::gen_waves (Addsynth *D, float fsamp, float fbase, float *scale)
 {
-    Pipewave::initstatic (fsamp);
-
     fbase *=  D->_fn / (D->_fd * scale [9]);
+
+    QVector<int> notes;
+    std::vector<uint32_t> seeds;
     for (int i = _n0; i <= _n1; i++)
     {
-	_pipes [i - _n0].genwave (D, i - _n0, fsamp, ldexpf (fbase * scale [i % 12], i / 12 - 5));
+        notes.append (i);
+        seeds.push_back (Pipewave::_rgen.irand () | 1);     // 0 would seed from the time
     }
+    QtConcurrent::blockingMap (notes, [this, D, fsamp, fbase, scale, &seeds](int i) {
+        Rngen rgen;
+        rgen.init (seeds [i - _n0]);
+        std::vector<float> arg ((int)(fsamp));
+        std::vector<float> att ((int)(0.5f * fsamp));
+	_pipes [i - _n0].genwave (D, i - _n0, fsamp, ldexpf (fbase * scale [i % 12], i / 12 - 5), rgen, arg.data (), att.data ());
+        });
+    // no pipe points into a previously loaded file anymore,
+    // unmap it so that save() can replace it
+    delete _file;
+    _file = 0;
     _modif = true;
 }
 
@@ -450,9 +478,15 @@ void Rankwave::play (int shift)
 }
 
 
+//---------------------------------------------------------
+//   save
+//    the file is written to a temporary file which then
+//    replaces it, as the old one may still be mapped by
+//    load() of this or another process
+//---------------------------------------------------------
+
 int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
 {
-    FILE      *F;
     Pipewave  *P;
     int        i;
     char       name [1024];
@@ -463,8 +497,8 @@ int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, flo
     if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
     else strcat (name, ".ae1");
 
-    F = fopen (name, "wb");
-    if (F == NULL)
+    QSaveFile F (name);
+    if (!F.open (QIODevice::WriteOnly))
     {
 	fprintf (stderr, "Can't open waveform file '%s' for writing\n", name);
         return 1;
@@ -472,14 +506,11 @@ int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, flo
 
     memset (data, 0, 16);
     strcpy (data, "ae1");
-    data [4] = 1;
-    fwrite (data, 1, 16, F);
+    data [4] = AE1_VERSION;
+    F.write (data, 16);
 
     memset (data, 0, 64);
-    data [0] = 0;
-    data [1] = 0;
-    data [2] = 0;
-    data [3] = 0;
+    memcpy (data, &D->_hash, 4);
     data [4] = _n0;
     data [5] = _n1;
     data [6] = 0;
@@ -487,106 +518,145 @@ int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, flo
     *((float *)(data +  8)) = fsamp;
     *((float *)(data + 12)) = fbase;
     memcpy (data + 16, scale, 12 * sizeof (float));
-    fwrite (data, 1, 64, F);
+    F.write (data, 64);
 
-    for (i = _n0, P = _pipes; i <= _n1; i++, P++) P->save (F);
+    for (i = _n0, P = _pipes; i <= _n1; i++, P++) P->save (&F);
 
-    fclose (F);
+    if (!F.commit ())
+    {
+	fprintf (stderr, "Can't write waveform file '%s'\n", name);
+        return 1;
+    }
 
     _modif = false;
     return 0;
 }
 
 
+//---------------------------------------------------------
+//   load
+//    map the wave file written by save(); the pipes point
+//    into the mapping, which lives as long as the Rankwave
+//---------------------------------------------------------
+
 int Rankwave::load (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
 {
-    FILE      *F;
     Pipewave  *P;
     int        i;
     char       name [1024];
     char       data [64];
     char      *p;
     float      f;
+    uint32_t   hash;
 
     sprintf (name, "%s/%s", path, D->_filename);
     if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
     else strcat (name, ".ae1");
 
-    F = fopen (name, "rb");
-    if (F == NULL)
+    QFile* F = new QFile (name);
+    const uchar* m = 0;
+    if (F->open (QIODevice::ReadOnly)) m = F->map (0, F->size ());
+    if (m == 0)
     {
 #ifdef DEBUG
-	fprintf (stderr, "Can't open waveform file '%s' for reading\n", name);
+	fprintf (stderr, "Can't map waveform file '%s' for reading\n", name);
 #endif
+        delete F;
         return 1;
     }
+    const uchar* end = m + F->size ();
 
-    fread (data, 1, 16, F);
-    if (strcmp (data, "ae1"))
+    if (end - m < 80 || memcmp (m, "ae1", 4))
     {
 #ifdef DEBUG
 	fprintf (stderr, "File '%s' is not an Aeolus waveform file\n", name);
 #endif
-        fclose (F);
+        delete F;
         return 1;
     }
 
-    if (data [4] != 1)
+    if (m [4] != AE1_VERSION)
     {
 #ifdef DEBUG
-	fprintf (stderr, "File '%s' has an incompatible version tag (%d)\n", name, data [4]);
+	fprintf (stderr, "File '%s' has an incompatible version tag (%d)\n", name, m [4]);
 #endif
-        fclose (F);
+        delete F;
         return 1;
     }
 
-    fread (data, 1, 64, F);
+    memcpy (data, m + 16, 64);
     if (_n0 != data [4] || _n1 != data [5])
     {
 #ifdef DEBUG
 	fprintf (stderr, "File '%s' has an incompatible note range (%d %d), (%d %d)\n", name, _n0, _n1, data [4], data [5]);
 #endif
-        fclose (F);
+        delete F;
+        return 1;
+    }
+
+    memcpy (&hash, data, 4);
+    if (hash != D->_hash)
+    {
+#ifdef DEBUG
+	fprintf (stderr, "File '%s' was generated from a different stop definition\n", name);
+#endif
+        delete F;
         return 1;
     }
 
-    f = *((float *)(data + 8));
+    memcpy (&f, data + 8, 4);
     if (fabsf (f - fsamp) > 0.1f)
     {
 #ifdef DEBUG
 	fprintf (stderr, "File '%s' has a different sample frequency (%3.1lf)\n", name, f);
 #endif
-        fclose (F);
+        delete F;
         return 1;
     }
 
-    f = *((float *)(data + 12));
+    memcpy (&f, data + 12, 4);
     if (fabsf (f - fbase) > 0.1f)
     {
 #ifdef DEBUG
 	fprintf (stderr, "File '%s' has a different tuning (%3.1lf)\n", name, f);
 #endif
-        fclose (F);
+        delete F;
         return 1;
     }
 
     for (i = 0; i < 12; i++)
     {
-        f = *((float *)(data + 16 + 4 * i));
+        memcpy (&f, data + 16 + 4 * i, 4);
         if (fabsf (f /  scale [i] - 1.0f) > 6e-5f)
         {
 #ifdef DEBUG
 	    fprintf (stderr, "File '%s' has a different temperament\n", name);
 #endif
-            fclose (F);
+            delete F;
             return 1;
         }
     }
 
-    for (i = _n0, P = _pipes; i <= _n1; i++, P++) P->load (F);
-
-    fclose (F);
+    const uchar* q = m + 80;
+    for (i = _n0, P = _pipes; i <= _n1; i++, P++)
+    {
+        if (!P->load (q, end))
+        {
+#ifdef DEBUG
+	    fprintf (stderr, "File '%s' is truncated\n", name);
+#endif
+            for (P = _pipes; P <= _pipes + (i - _n0); P++)
+            {
+                if (P->_mapped) P->_p0 = 0;
+                P->_mapped = false;
+            }
+            delete F;
+            return 1;
+        }
+    }
 
+    delete _file;
+    _file = F;
     _modif = false;
     return 0;
 }
@@ -33,22 +33,23 @@ class Pipewave
 private:
 
     Pipewave () :
-        _p0 (0), _p1 (0), _p2 (0), _l1 (0), _k_s (0),  _k_r (0), _m_r (0),
+        _p0 (0), _p1 (0), _p2 (0), _l1 (0), _k_s (0),  _k_r (0), _m_r (0), _d_r (0), _d_p (0),
+        _mapped (false),
         _link (0), _sbit (0), _sdel (0),
         _p_p (0), _y_p (0), _z_p (0), _p_r (0), _y_r (0), _g_r (0), _i_r (0)
     {}
 
-    ~Pipewave (void) { delete[] _p0; }
+    ~Pipewave (void) { if (!_mapped) delete[] _p0; }
 
     friend class Rankwave;
 
-    void genwave (Addsynth *D, int n, float fsamp, float fpipe);
-    void save (FILE *F);
-    void load (FILE *F);
+    void genwave (Addsynth *D, int n, float fsamp, float fpipe, Rngen& rgen, float *arg, float *att);
+    void save (QIODevice *F);
+    bool load (const uchar*& p, const uchar* end);
     void play (void);
 
     static void looplen (float f, float fsamp, int lmax, int *aa, int *bb);
-    static void attgain (int n, float p);
+    static void attgain (int n, float p, float *att);
 
     float     *_p0;    // attack start
     float     *_p1;    // loop start
@@ -60,6 +61,7 @@ private:
     float      _m_r;   // release multiplier
     float      _d_r;   // release detune
     float      _d_p;   // instability
+    bool       _mapped; // _p0 points into the mapped wave file
 
     Pipewave  *_link;  // link to next in active chain
     uint32_t   _sbit;  // on state bit
@@ -73,12 +75,7 @@ private:
     float      _g_r;   // release gain
     int16_t    _i_r;   // release count
 
-
-    static void initstatic (float fsamp);
-
     static   Rngen   _rgen;
-    static   float  *_arg;
-    static   float  *_att;
 };
 
 //---------------------------------------------------------
@@ -96,6 +93,7 @@ class Rankwave
       Pipewave   *_list;
       Pipewave   *_pipes;
       bool        _modif;
+      QFile      *_file;        // mapped wave file the pipes point into
 
 public:
 
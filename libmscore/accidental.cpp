@@ -22,6 +22,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Accidental)
+
 //---------------------------------------------------------
 //   Acc
 //---------------------------------------------------------
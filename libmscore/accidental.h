@@ -221,6 +221,8 @@ class Accidental : public Element {
       static bool isMicrotonal(AccidentalType t)  { return t > AccidentalType::FLAT2; }
 
       QString accessibleInfo() const override;
+
+      ELEMENT_POOL
       };
 
 extern AccidentalVal sym2accidentalVal(SymId id);
@@ -35,6 +35,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Beam)
+
 //---------------------------------------------------------
 //   BeamFragment
 //    position of primary beam
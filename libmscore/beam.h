@@ -154,6 +154,8 @@ class Beam : public Element {
       bool cross() const   { return _cross; }
       virtual Shape shape() const override;
       virtual void triggerLayout() const override;
+
+      ELEMENT_POOL
       };
 
 
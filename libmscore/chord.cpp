@@ -55,6 +55,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Chord)
+
 //---------------------------------------------------------
 //   LedgerLineData
 //---------------------------------------------------------
@@ -227,6 +227,8 @@ class Chord : public ChordRest {
       virtual QString accessibleExtraInfo() const override;
 
       virtual Shape shape() const override;
+
+      ELEMENT_POOL
       };
 
 
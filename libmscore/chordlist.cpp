@@ -464,6 +464,29 @@ void ParsedChord::correctXmlText(const QString& s)
 //---------------------------------------------------------
 
 bool ParsedChord::parse(const QString& s, const ChordList* cl, bool syntaxOnly, bool preferMinor)
+      {
+      // identical strings parse identically against the same chord list,
+      // so reuse the result of an earlier parse
+      QString key;
+      if (cl) {
+            key = QString("%1%2").arg(int(syntaxOnly)).arg(int(preferMinor)) + s;
+            auto i = cl->_parseCache.constFind(key);
+            if (i != cl->_parseCache.constEnd()) {
+                  *this = i.value();
+                  return _parseable;
+                  }
+            }
+      parseString(s, cl, syntaxOnly, preferMinor);
+      if (cl)
+            cl->_parseCache.insert(key, *this);
+      return _parseable;
+      }
+
+//---------------------------------------------------------
+//  parseString
+//---------------------------------------------------------
+
+void ParsedChord::parseString(const QString& s, const ChordList* cl, bool syntaxOnly, bool preferMinor)
       {
       QString tok1, tok1L, tok2, tok2L;
       QString extensionDigits = "123456789";
@@ -1136,7 +1159,6 @@ bool ParsedChord::parse(const QString& s, const ChordList* cl, bool syntaxOnly,
                   qDebug("parse: xmlDegrees = <%s>", qPrintable(_xmlDegrees.join(",")));
                   }
             }
-      return _parseable;
       }
 
 //---------------------------------------------------------
@@ -1376,10 +1398,24 @@ QString ParsedChord::fromXml(const QString& rawKind, const QString& rawKindText,
 
 const QList<RenderAction>& ParsedChord::renderList(const ChordList* cl)
       {
-      // generate anew on each call,
-      // in case chord list has changed since last time
       if (!_renderList.empty())
             _renderList.clear();
+      // the chord list remembers the render list of each token sequence,
+      // which only depends on its token definitions; ChordList::read()
+      // and unload() clear the memo when these change
+      // token names are length prefixed as they may contain any character
+      QString key;
+      if (cl) {
+            for (const ChordToken& tok : _tokenList) {
+                  const QString& n = tok.names.first();
+                  key += QString("%1:%2:").arg(int(tok.tokenClass)).arg(n.size()) + n;
+                  }
+            auto i = cl->_renderCache.constFind(key);
+            if (i != cl->_renderCache.constEnd()) {
+                  _renderList = i.value();
+                  return _renderList;
+                  }
+            }
       foreach (ChordToken tok, _tokenList) {
             QString n = tok.names.first();
             QList<RenderAction> rl;
@@ -1415,6 +1451,8 @@ const QList<RenderAction>& ParsedChord::renderList(const ChordList* cl)
                   _renderList.append(a);
                   }
             }
+      if (cl)
+            cl->_renderCache.insert(key, _renderList);
       return _renderList;
       }
 
@@ -1559,12 +1597,16 @@ void ChordDescription::write(XmlWriter& xml) const
 
 int ChordList::privateID = -1000;
 
+static const int FILE_CACHE_SIZE = 16;    // chord description files shared by ChordList::read()
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
 
 void ChordList::read(XmlReader& e)
       {
+      _fileKey.clear();
+      clearCaches();
       int fontIdx = 0;
       while (e.readNextStartElement()) {
             const QStringRef& tag(e.name());
@@ -1648,6 +1690,8 @@ void ChordList::read(XmlReader& e)
             else
                   e.unknown();
             }
+      // chords parsed above may have seen only part of the token list
+      clearCaches();
       }
 
 //---------------------------------------------------------
@@ -1715,6 +1759,24 @@ bool ChordList::read(const QString& name)
 
       if (name.isEmpty())
             return false;
+
+      // a file read into an empty list, or on top of other files only,
+      // always gives the same result; share it instead of parsing again
+      // scores may read chord lists from several threads
+      static QMutex fileCacheMutex;
+      static QCache<QString, ChordList> fileCache(FILE_CACHE_SIZE);
+      QFileInfo pfi(path);
+      QString key = QString("%1%2|%3;").arg(_fileKey).arg(pfi.absoluteFilePath()).arg(pfi.lastModified().toMSecsSinceEpoch());
+      bool cacheable = fromFilesOnly();
+      if (cacheable) {
+            QMutexLocker locker(&fileCacheMutex);
+            if (ChordList* cl = fileCache.object(key)) {
+                  *this = *cl;
+                  docName = path;
+                  return true;
+                  }
+            }
+
       QFile f(path);
       if (!f.open(QIODevice::ReadOnly)) {
             MScore::lastError = QObject::tr("Cannot open chord description:\n%1\n%2").arg(f.fileName()).arg(f.errorString());
@@ -1730,6 +1792,12 @@ bool ChordList::read(const QString& name)
                   // QStringList sl = version.split('.');
                   // int _mscVersion = sl[0].toInt() * 100 + sl[1].toInt();
                   read(e);
+                  if (cacheable) {
+                        _fileKey   = key;
+                        _fileCount = size();
+                        QMutexLocker locker(&fileCacheMutex);
+                        fileCache.insert(key, new ChordList(*this));
+                        }
                   return true;
                   }
             }
@@ -1794,6 +1862,33 @@ void ChordList::unload()
       renderListRoot.clear();
       renderListBase.clear();
       chordTokenList.clear();
+      _fileKey.clear();
+      _fileCount = 0;
+      clearCaches();
+      }
+
+//---------------------------------------------------------
+//   fromFilesOnly
+//    true if the list is empty or holds nothing but
+//    description files read by read(const QString&)
+//---------------------------------------------------------
+
+bool ChordList::fromFilesOnly() const
+      {
+      if (!_fileKey.isEmpty())
+            return size() == _fileCount;
+      return isEmpty() && symbols.isEmpty() && fonts.isEmpty() && chordTokenList.isEmpty()
+         && renderListRoot.isEmpty() && renderListBase.isEmpty();
+      }
+
+//---------------------------------------------------------
+//   clearCaches
+//---------------------------------------------------------
+
+void ChordList::clearCaches()
+      {
+      _parseCache.clear();
+      _renderCache.clear();
       }
 
 
@@ -162,6 +162,7 @@ class ParsedChord {
       bool _parseable;
       bool _understandable;
       void configure(const ChordList*);
+      void parseString(const QString&, const ChordList*, bool syntaxOnly, bool preferMinor);
       void correctXmlText(const QString& s = "");
       void addToken(QString, ChordTokenClass);
       };
@@ -227,6 +228,15 @@ struct ChordFont {
 
 class ChordList : public QMap<int, ChordDescription> {
       QMap<QString, ChordSymbol> symbols;
+      QString _fileKey;             // description files read into an otherwise empty list
+      int _fileCount { 0 };         // number of descriptions read from them
+      mutable QHash<QString, ParsedChord> _parseCache;            // keyed by parse() flags + input string
+      mutable QHash<QString, QList<RenderAction>> _renderCache;   // keyed by token list
+
+      bool fromFilesOnly() const;
+      void clearCaches();
+
+      friend class ParsedChord;
 
    public:
       QList<ChordFont> fonts;
@@ -218,8 +218,17 @@ void Score::update()
             CmdState& cs = ms->cmdState();
             ms->deletePostponed();
             if (cs.layoutRange()) {
+                  // while the scores are edited in views, parts not shown
+                  // in any view are laid out later, see doPendingLayout()
+                  bool viewed = false;
                   for (Score* s : ms->scoreList())
-                        s->doLayoutRange(cs.startTick(), cs.endTick());
+                        viewed = viewed || !s->viewer.isEmpty();
+                  for (Score* s : ms->scoreList()) {
+                        s->deferLayoutRange(cs.startTick(), cs.endTick(), cs.layoutFlags);
+                        if (s == ms || !viewed || !s->viewer.isEmpty())
+                              s->doPendingLayout();
+                        }
+                  ms->addChangedRange(cs.startTick(), cs.endTick());
                   updateAll = true;
                   }
             }
@@ -22,6 +22,8 @@
 #include "libmscore/system.h"
 #include "libmscore/segment.h"
 #include "libmscore/timesig.h"
+#include "libmscore/staff.h"
+#include "libmscore/undo.h"
 #include "cursor.h"
 
 namespace Ms {
@@ -347,6 +349,115 @@ void Cursor::nextInTrack()
             _segment = _segment->next1(_filter);
       }
 
+//---------------------------------------------------------
+//   rangeNotes
+//    notes of staves staffStart..staffEnd-1 whose chords start
+//    in startTick..endTick-1, in segment, track, grace note order
+//---------------------------------------------------------
+
+std::vector<Note*> Cursor::rangeNotes(int staffStart, int staffEnd, int startTick, int endTick) const
+      {
+      std::vector<Note*> notes;
+      if (!_score)
+            return notes;
+      staffStart = qMax(staffStart, 0);
+      staffEnd   = qMin(staffEnd, _score->nstaves());
+      if (endTick < 0)
+            endTick = _score->lastMeasure() ? _score->lastMeasure()->endTick() : 0;
+      Measure* m = _score->tick2measure(qMax(startTick, 0));
+      if (!m || staffStart >= staffEnd)
+            return notes;
+      int startTrack = staffStart * VOICES;
+      int endTrack   = staffEnd * VOICES;
+
+      for (Segment* s = m->first(SegmentType::ChordRest); s && s->tick() < endTick; s = s->next1(SegmentType::ChordRest)) {
+            if (s->tick() < startTick)
+                  continue;
+            for (int track = startTrack; track < endTrack; ++track) {
+                  Element* e = s->element(track);
+                  if (!e || !e->isChord())
+                        continue;
+                  Chord* c = toChord(e);
+                  for (Chord* gc : c->graceNotes())
+                        notes.insert(notes.end(), gc->notes().begin(), gc->notes().end());
+                  notes.insert(notes.end(), c->notes().begin(), c->notes().end());
+                  }
+            }
+      return notes;
+      }
+
+//---------------------------------------------------------
+//   noteData
+//---------------------------------------------------------
+
+QVariantMap Cursor::noteData(int staffStart, int staffEnd, int startTick, int endTick) const
+      {
+      std::vector<Note*> notes = rangeNotes(staffStart, staffEnd, startTick, endTick);
+      // dynamics may have changed since the last layout
+      if (!notes.empty())
+            _score->updateVelo();
+      QList<int> ticks, tracks, pitches, tpcs, durations, velocities;
+      for (QList<int>* l : { &ticks, &tracks, &pitches, &tpcs, &durations, &velocities })
+            l->reserve(int(notes.size()));
+
+      for (Note* n : notes) {
+            Chord* c = n->chord();
+            int tick = c->tick();
+            ticks.append(tick);
+            tracks.append(n->track());
+            pitches.append(n->pitch());
+            tpcs.append(n->tpc());
+            durations.append(c->actualTicks());
+            velocities.append(n->customizeVelocity(n->staff()->velocities().velo(tick)));
+            }
+
+      QVariantMap data;
+      data["tick"]     = QVariant::fromValue(ticks);
+      data["track"]    = QVariant::fromValue(tracks);
+      data["pitch"]    = QVariant::fromValue(pitches);
+      data["tpc"]      = QVariant::fromValue(tpcs);
+      data["duration"] = QVariant::fromValue(durations);
+      data["velocity"] = QVariant::fromValue(velocities);
+      return data;
+      }
+
+//---------------------------------------------------------
+//   applyNoteProperty
+//---------------------------------------------------------
+
+int Cursor::applyNoteProperty(int staffStart, int staffEnd, int startTick, int endTick,
+   const QString& name, const QVariantList& values)
+      {
+      if (!_score)
+            return 0;
+      P_ID pid = propertyId(name);
+      if (pid == P_ID::END) {
+            qDebug("Cursor::applyNoteProperty: unknown property <%s>", qPrintable(name));
+            return 0;
+            }
+      std::vector<Note*> notes = rangeNotes(staffStart, staffEnd, startTick, endTick);
+      int n = qMin(int(notes.size()), values.size());
+
+      // join a command already started by the plugin
+      bool ownCmd = !_score->undoStack()->active();
+      if (ownCmd)
+            _score->startCmd();
+      int changed = 0;
+      for (int i = 0; i < n; ++i) {
+            const QVariant& v = values[i];
+            if (v.isNull() || !v.isValid())
+                  continue;
+            Note* note = notes[i];
+            if (note->getProperty(pid) == v)
+                  continue;
+            note->undoChangeProperty(pid, v);
+            ++changed;
+            }
+      if (ownCmd)
+            _score->endCmd();
+      return changed;
+      }
+
 //---------------------------------------------------------
 //   qmlKeySignature
 //   read access to key signature in current track
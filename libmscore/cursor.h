@@ -66,6 +66,11 @@ class ElementW : public QObject {
 //   @P time      double        time at tick position, read only
 //   @P keySignature int        key signature of current staff at tick pos. (read only)
 //   @P score     Ms::Score*    associated score
+//
+//   Bulk access for scripts walking many notes:
+//   noteData() returns the notes of a staff and tick range as
+//   parallel arrays, applyNoteProperty() changes one property
+//   for the same notes in a single undoable command.
 //---------------------------------------------------------
 
 class Cursor : public QObject {
@@ -94,6 +99,7 @@ class Cursor : public QObject {
 
       // utility methods
       void nextInTrack();
+      std::vector<Note*> rangeNotes(int staffStart, int staffEnd, int startTick, int endTick) const;
 
    public:
       Cursor(Score* c = 0);
@@ -141,6 +147,17 @@ class Cursor : public QObject {
       //@   n: denominator
       //@   Quarter, if n == 0
       Q_INVOKABLE void setDuration(int z, int n);
+
+      //@ notes of staves staffStart..staffEnd-1 starting in startTick..endTick-1 (endTick < 0: end of score)
+      //@ returns an object with the arrays tick, track, pitch, tpc, duration and velocity,
+      //@ one entry per note in score order
+      Q_INVOKABLE QVariantMap noteData(int staffStart, int staffEnd, int startTick, int endTick) const;
+
+      //@ set property 'name' of the notes returned by noteData() for the same range
+      //@ to the corresponding entry of 'values', null entries are skipped
+      //@ returns the number of changed notes
+      Q_INVOKABLE int applyNoteProperty(int staffStart, int staffEnd, int startTick, int endTick,
+         const QString& name, const QVariantList& values);
       };
 
 }     // namespace Ms
@@ -17,6 +17,7 @@
 #include "fraction.h"
 #include "scoreElement.h"
 #include "shape.h"
+#include "elementpool.h"
 
 namespace Ms {
 
@@ -156,15 +157,15 @@ class Element : public ScoreElement {
             };
 
   private:
-      Placement _placement;
       int _track;                 ///< staffIdx * VOICES + voice
+      uint _tag;                  ///< tag bitmask
       qreal _mag;                 ///< standard magnification (derived value)
       QPointF _pos;               ///< Reference position, relative to _parent.
       QPointF _userOff;           ///< offset from normal layout position:
       QPointF _readPos;
       mutable QRectF _bbox;       ///< Bounding box relative to _pos + _userOff
                                   ///< valid after call to layout()
-      uint _tag;                  ///< tag bitmask
+      Placement _placement;       // last, so that small members of derived classes fill the padding
 
    public:
       Element(Score* s = 0);
@@ -0,0 +1,139 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "elementpool.h"
+
+namespace Ms {
+
+static const int CHUNK_SIZE  = 64 * 1024;
+static const size_t ALIGN   = 16;
+
+//---------------------------------------------------------
+//   ElementPool
+//---------------------------------------------------------
+
+ElementPool::ElementPool(const char* name, size_t size)
+   : _name(name)
+      {
+      _size     = (qMax(size, sizeof(void*)) + ALIGN - 1) & ~(ALIGN - 1);
+      _perChunk = qMax(1, int(CHUNK_SIZE / _size));
+      pools().append(this);
+      }
+
+//---------------------------------------------------------
+//   pools
+//---------------------------------------------------------
+
+QList<ElementPool*>& ElementPool::pools()
+      {
+      static QList<ElementPool*>* list = new QList<ElementPool*>;
+      return *list;
+      }
+
+//---------------------------------------------------------
+//   allPools
+//---------------------------------------------------------
+
+QList<const ElementPool*> ElementPool::allPools()
+      {
+      QList<const ElementPool*> list;
+      for (const ElementPool* p : pools())
+            list.append(p);
+      return list;
+      }
+
+//---------------------------------------------------------
+//   chunk
+//    return the chunk containing p
+//---------------------------------------------------------
+
+ElementPool::Chunk* ElementPool::chunk(const void* p) const
+      {
+      auto i = _chunks.upperBound(static_cast<const char*>(p));
+      Q_ASSERT(i != _chunks.begin());
+      return (--i).value();
+      }
+
+//---------------------------------------------------------
+//   alloc
+//---------------------------------------------------------
+
+void* ElementPool::alloc(size_t size)
+      {
+      if (size > _size)
+            return ::operator new(size);
+      QMutexLocker locker(&_mutex);
+      if (_partial.isEmpty()) {
+            Chunk* c = new Chunk;
+            c->mem   = static_cast<char*>(::operator new(_perChunk * _size));
+            for (int i = _perChunk - 1; i >= 0; --i) {
+                  void* p = c->mem + i * _size;
+                  *static_cast<void**>(p) = c->free;
+                  c->free = p;
+                  }
+            _chunks.insert(c->mem, c);
+            _partial.append(c);
+            }
+      Chunk* c = _partial.last();
+      void* p  = c->free;
+      c->free  = *static_cast<void**>(p);
+      if (++c->live == _perChunk)
+            _partial.removeLast();
+      ++_allocations;
+      if (++_live > _peak)
+            _peak = _live;
+      return p;
+      }
+
+//---------------------------------------------------------
+//   free
+//---------------------------------------------------------
+
+void ElementPool::free(void* p, size_t size)
+      {
+      if (!p)
+            return;
+      if (size > _size) {
+            ::operator delete(p);
+            return;
+            }
+      QMutexLocker locker(&_mutex);
+      --_live;
+      Chunk* c = chunk(p);
+      *static_cast<void**>(p) = c->free;
+      c->free = p;
+      if (c->live-- == _perChunk)
+            _partial.append(c);
+      // give an unused chunk back unless it is the only one
+      // left to allocate from, so that creating and deleting
+      // a single object does not allocate a chunk every time
+      if (c->live == 0 && _partial.size() > 1) {
+            _partial.removeOne(c);
+            _chunks.remove(c->mem);
+            ::operator delete(c->mem);
+            delete c;
+            }
+      }
+
+//---------------------------------------------------------
+//   dumpStatistics
+//---------------------------------------------------------
+
+void ElementPool::dumpStatistics()
+      {
+      for (const ElementPool* p : pools()) {
+            qDebug("%-12s size %4d  allocations %8lld  live %7d  peak %7d  chunks %5d  bytes %9lld",
+               p->name(), int(p->objectSize()), p->allocations(), p->live(), p->peak(), p->chunks(), p->bytes());
+            }
+      }
+
+}
@@ -0,0 +1,85 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __ELEMENTPOOL_H__
+#define __ELEMENTPOOL_H__
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   ElementPool
+//    free list allocator for the objects of one element
+//    type; memory is taken from the system in chunks, a
+//    chunk is given back as soon as none of its objects is
+//    in use, except for the last chunk with free slots
+//---------------------------------------------------------
+
+class ElementPool {
+      struct Chunk {
+            char* mem;
+            void* free { 0 };       // free list, linked through the first word of the object
+            int live   { 0 };
+            };
+
+      const char* _name;
+      size_t _size;                 // object size, rounded up for the free list link
+      int _perChunk;
+      QMap<const char*, Chunk*> _chunks;  // by address
+      QList<Chunk*> _partial;       // chunks with free slots
+      int _live { 0 };
+      int _peak { 0 };
+      qint64 _allocations { 0 };
+      QMutex _mutex;
+
+      static QList<ElementPool*>& pools();
+      Chunk* chunk(const void* p) const;
+
+   public:
+      ElementPool(const char* name, size_t size);
+
+      void* alloc(size_t size);
+      void free(void* p, size_t size);
+
+      const char* name() const      { return _name; }
+      size_t objectSize() const     { return _size; }
+      int live() const              { return _live; }
+      int peak() const              { return _peak; }
+      qint64 allocations() const    { return _allocations; }
+      int chunks() const            { return _chunks.size(); }
+      qint64 bytes() const          { return qint64(_chunks.size()) * _perChunk * _size; }
+
+      static QList<const ElementPool*> allPools();
+      static void dumpStatistics();
+      };
+
+//---------------------------------------------------------
+//   ELEMENT_POOL
+//    give an element class its own ElementPool;
+//    derived classes of other size use the global heap
+//---------------------------------------------------------
+
+#define ELEMENT_POOL                                                                \
+   public:                                                                          \
+      static void* operator new(size_t size)          { return pool().alloc(size); } \
+      static void operator delete(void* p, size_t size) { pool().free(p, size); }   \
+      static ElementPool& pool();                                                   \
+   private:
+
+#define ELEMENT_POOL_DEFINE(T)                                                      \
+      ElementPool& T::pool()                                                        \
+            {                                                                       \
+            static ElementPool* p = new ElementPool(#T, sizeof(T));                 \
+            return *p;                                                              \
+            }
+
+}     // namespace Ms
+#endif
@@ -47,6 +47,88 @@ class FifoBase {
       bool isFull() const     { return maxCount == counter; }
       };
 
+//---------------------------------------------------------
+//   MPSCQueue
+//    bounded queue for any number of writers and one reader
+//    - a writer claims a cell by advancing widx with a
+//      compare-and-swap and publishes it by storing the
+//      cell sequence number
+//    - writers never wait for the reader: if the queue is
+//      full, enqueue() drops the object and counts an overflow
+//    - enqueue() is lock-free but not wait-free: a writer
+//      retries its compare-and-swap while other writers win
+//      the same cell, the number of retries is not bounded
+//    - dequeue() is wait-free, the reader only writes ridx
+//    - N must be a power of two
+//---------------------------------------------------------
+
+template <typename T, unsigned N>
+class MPSCQueue {
+      static_assert(N && !(N & (N - 1)), "MPSCQueue size must be a power of two");
+
+      struct Cell {
+            std::atomic<unsigned> seq;
+            T data;
+            };
+
+      Cell cells[N];
+      std::atomic<unsigned> widx;     // next cell to claim, shared by writers
+      unsigned ridx;                  // next cell to read, reader only
+      std::atomic<int> _overflows;    // objects dropped because the queue was full
+
+   public:
+      MPSCQueue() : widx(0), ridx(0), _overflows(0) {
+            for (unsigned i = 0; i < N; ++i)
+                  cells[i].seq.store(i, std::memory_order_relaxed);
+            }
+
+      //---------------------------------------------------
+      //   enqueue
+      //    return false if the queue is full
+      //---------------------------------------------------
+
+      bool enqueue(const T& val) {
+            unsigned pos = widx.load(std::memory_order_relaxed);
+            for (;;) {
+                  Cell& cell = cells[pos & (N - 1)];
+                  int diff = int(cell.seq.load(std::memory_order_acquire) - pos);
+                  if (diff == 0) {
+                        if (widx.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                              cell.data = val;
+                              cell.seq.store(pos + 1, std::memory_order_release);
+                              return true;
+                              }
+                        }
+                  else if (diff < 0) {
+                        ++_overflows;
+                        return false;
+                        }
+                  else
+                        pos = widx.load(std::memory_order_relaxed);
+                  }
+            }
+
+      //---------------------------------------------------
+      //   dequeue
+      //    return false if there is no published object
+      //---------------------------------------------------
+
+      bool dequeue(T& val) {
+            Cell& cell = cells[ridx & (N - 1)];
+            if (int(cell.seq.load(std::memory_order_acquire) - (ridx + 1)) < 0)
+                  return false;
+            val = cell.data;
+            cell.seq.store(ridx + N, std::memory_order_release);
+            ++ridx;
+            return true;
+            }
+
+      bool empty() const {
+            return int(cells[ridx & (N - 1)].seq.load(std::memory_order_acquire) - (ridx + 1)) < 0;
+            }
+      int overflows() const   { return _overflows; }
+      };
+
 
 }     // namespace Ms
 #endif
@@ -18,6 +18,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Hook)
+
 //---------------------------------------------------------
 //   Hook
 //---------------------------------------------------------
@@ -38,6 +38,8 @@ class Hook : public Symbol {
       virtual void layout() override;
       virtual void draw(QPainter*) const override;
       Chord* chord() const                         { return (Chord*)parent(); }
+
+      ELEMENT_POOL
       };
 
 
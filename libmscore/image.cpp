@@ -35,10 +35,9 @@ Image::Image(Score* s)
    : BSymbol(s)
       {
       imageType        = ImageType::NONE;
-      rasterDoc        = 0;
+      svgDoc           = 0;
       _size            = QSizeF(0, 0);
       _storeItem       = 0;
-      _dirty           = false;
       _lockAspectRatio = defaultLockAspectRatio;
       _autoScale       = defaultAutoScale;
       _sizeIsSpatium   = defaultSizeIsSpatium;
@@ -49,21 +48,19 @@ Image::Image(const Image& img)
    : BSymbol(img)
       {
       imageType        = img.imageType;
-      buffer           = img.buffer;
+      rasterSize       = img.rasterSize;
       _size            = img._size;
       _lockAspectRatio = img._lockAspectRatio;
       _autoScale       = img._autoScale;
-      _dirty           = img._dirty;
       _storeItem       = img._storeItem;
       _sizeIsSpatium   = img._sizeIsSpatium;
       if (_storeItem)
             _storeItem->reference(this);
       _linkPath        = img._linkPath;
       _linkIsValid     = img._linkIsValid;
-      if (imageType == ImageType::RASTER)
-            rasterDoc = img.rasterDoc ? new QImage(*img.rasterDoc) : 0;
-      else if (imageType == ImageType::SVG)
-            svgDoc = img.svgDoc ? new QSvgRenderer(_storeItem->buffer()) : 0;
+      svgDoc           = 0;
+      if (imageType == ImageType::SVG && img.svgDoc)
+            svgDoc = new QSvgRenderer(_storeItem->buffer());
       setZ(img.z());
       }
 
@@ -75,10 +72,7 @@ Image::~Image()
       {
       if (_storeItem)
             _storeItem->dereference(this);
-      if (imageType == ImageType::SVG)
-            delete svgDoc;
-      else if (imageType == ImageType::RASTER)
-            delete rasterDoc;
+      delete svgDoc;
       }
 
 //---------------------------------------------------------
@@ -88,11 +82,7 @@ Image::~Image()
 void Image::setImageType(ImageType t)
       {
       imageType = t;
-      if (imageType == ImageType::SVG)
-            svgDoc = 0;
-      else if (imageType == ImageType::RASTER)
-            rasterDoc = 0;
-      else
+      if (imageType != ImageType::SVG && imageType != ImageType::RASTER)
             qDebug("illegal image type");
       }
 
@@ -104,7 +94,7 @@ QSizeF Image::imageSize() const
       {
       if (!isValid())
             return QSizeF();
-      return imageType == ImageType::RASTER ? rasterDoc->size() : svgDoc->defaultSize();
+      return imageType == ImageType::RASTER ? rasterSize : svgDoc->defaultSize();
       }
 
 //---------------------------------------------------------
@@ -121,7 +111,7 @@ void Image::draw(QPainter* painter) const
                   svgDoc->render(painter, bbox());
             }
       else if (imageType == ImageType::RASTER) {
-            if (rasterDoc == nullptr)
+            if (!_storeItem || rasterSize.isEmpty())
                   emptyImage = true;
             else {
                   painter->save();
@@ -132,22 +122,20 @@ void Image::draw(QPainter* painter) const
                         s = _size * DPMM;
                   if (score()->printing() && !MScore::svgPrinting) {
                         // use original image size for printing, but not for svg for reasonable file size.
-                        painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                        painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                        painter->scale(s.width() / rasterSize.width(), s.height() / rasterSize.height());
+                        painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(_storeItem->image()));
                         }
                   else {
                         QTransform t = painter->transform();
                         QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
                         t.setMatrix(1.0, t.m12(), t.m13(), t.m21(), 1.0, t.m23(), t.m31(), t.m32(), t.m33());
                         painter->setWorldTransform(t);
-                        if ((buffer.size() != ss || _dirty) && rasterDoc && !rasterDoc->isNull()) {
-                              buffer = QPixmap::fromImage(rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-                              _dirty = false;
-                              }
-                        if (buffer.isNull())
+                        // scaled rasters are shared by all images through the image store
+                        QPixmap pm = _storeItem->pixmap(ss);
+                        if (pm.isNull())
                               emptyImage = true;
                         else
-                              painter->drawPixmap(QPointF(0.0, 0.0), buffer);
+                              painter->drawPixmap(QPointF(0.0, 0.0), pm);
                         }
                   painter->restore();
                   }
@@ -451,13 +439,9 @@ void Image::layout()
             if (_storeItem)
                   svgDoc = new QSvgRenderer(_storeItem->buffer());
             }
-      else if (imageType == ImageType::RASTER && !rasterDoc) {
-            if (_storeItem) {
-                  rasterDoc = new QImage;
-                  rasterDoc->loadFromData(_storeItem->buffer());
-                  if (!rasterDoc->isNull())
-                        _dirty = true;
-                  }
+      else if (imageType == ImageType::RASTER && !rasterSize.isValid()) {
+            if (_storeItem)
+                  rasterSize = _storeItem->image().size();
             }
       if (_size.isNull())
             _size = pixel2size(imageSize());
@@ -538,7 +522,6 @@ bool Image::setProperty(P_ID propertyId, const QVariant& v)
                   break;
             }
       setGenerated(false);
-      _dirty = true;
       triggerLayout();
       return rv;
       }
@@ -26,10 +26,8 @@ enum class ImageType : char { NONE, RASTER, SVG };
 //---------------------------------------------------------
 
 class Image : public BSymbol {
-      union {
-            QImage*       rasterDoc;
-            QSvgRenderer* svgDoc;
-            };
+      QSvgRenderer* svgDoc;
+      QSize rasterSize;             ///< size of the decoded raster image, invalid if not decoded yet
       ImageType imageType;
       Q_GADGET
 
@@ -41,12 +39,10 @@ class Image : public BSymbol {
       QString _storePath;           // the path of the img in the ImageStore
       QString _linkPath;            // the path of an external linked img
       bool _linkIsValid;            // whether _linkPath file exists or not
-      mutable QPixmap buffer;       ///< cached rendering
       QSizeF _size;                 // in mm or spatium units
       bool _lockAspectRatio;
       bool _autoScale;              ///< fill parent frame
       bool _sizeIsSpatium;
-      mutable bool _dirty;
 
       virtual bool isEditable() const override { return true; }
       virtual void startEdit(EditData&) override;
@@ -86,7 +82,7 @@ class Image : public BSymbol {
       QSizeF imageSize() const;
 
       void setImageType(ImageType);
-      bool isValid() const           { return rasterDoc || svgDoc; }
+      bool isValid() const           { return svgDoc || rasterSize.isValid(); }
       };
 
 
@@ -19,6 +19,31 @@ namespace Ms {
 
 ImageStore imageStore;  // the global image store
 
+//---------------------------------------------------------
+//   decoded and scaled rasters, shared by all images
+//    cost is in kB; the caches are never destroyed, as
+//    pixmaps must not outlive the application object
+//---------------------------------------------------------
+
+static const int DEFAULT_CACHE_LIMIT = 64 * 1024;
+
+static QCache<QByteArray, QImage>& imageCache()
+      {
+      static QCache<QByteArray, QImage>* cache = new QCache<QByteArray, QImage>(DEFAULT_CACHE_LIMIT / 2);
+      return *cache;
+      }
+
+static QCache<QByteArray, QPixmap>& pixmapCache()
+      {
+      static QCache<QByteArray, QPixmap>* cache = new QCache<QByteArray, QPixmap>(DEFAULT_CACHE_LIMIT / 2);
+      return *cache;
+      }
+
+static int imageCost(const QImage& image)
+      {
+      return qMax(1, image.byteCount() / 1024);
+      }
+
 //---------------------------------------------------------
 //   ImageStoreItem
 //---------------------------------------------------------
@@ -36,6 +61,8 @@ ImageStoreItem::ImageStoreItem(const QString& p)
 void ImageStoreItem::dereference(Image* image)
       {
       _references.removeOne(image);
+      if (_references.isEmpty())
+            imageStore.setUnused(this);
       }
 
 //---------------------------------------------------------
@@ -45,6 +72,8 @@ void ImageStoreItem::dereference(Image* image)
 
 void ImageStoreItem::reference(Image* image)
       {
+      if (_references.isEmpty())
+            imageStore.setUsed(this);
       _references.append(image);
       }
 
@@ -82,6 +111,44 @@ void ImageStoreItem::load()
       _hash = h.result();
       }
 
+//---------------------------------------------------------
+//   image
+//    return the decoded raster image
+//---------------------------------------------------------
+
+QImage ImageStoreItem::image() const
+      {
+      QImage* cached = imageCache().object(_hash);
+      if (cached)
+            return *cached;
+      QImage image;
+      image.loadFromData(_buffer);
+      if (!image.isNull())
+            imageCache().insert(_hash, new QImage(image), imageCost(image));
+      return image;
+      }
+
+//---------------------------------------------------------
+//   pixmap
+//    return the raster image scaled to size
+//---------------------------------------------------------
+
+QPixmap ImageStoreItem::pixmap(const QSize& size) const
+      {
+      QByteArray key(_hash);
+      key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+      QPixmap* cached = pixmapCache().object(key);
+      if (cached)
+            return *cached;
+      QImage original = image();
+      if (original.isNull() || size.isEmpty())
+            return QPixmap();
+      QImage scaled = original.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+      QPixmap pm = QPixmap::fromImage(scaled);
+      pixmapCache().insert(key, new QPixmap(pm), imageCost(scaled));
+      return pm;
+      }
+
 //---------------------------------------------------------
 //   hashName
 //---------------------------------------------------------
@@ -165,10 +232,9 @@ ImageStoreItem* ImageStore::getImage(const QString& path) const
       for (int i = 0; i < 16; ++i) {
             hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
             }
-      foreach(ImageStoreItem* item, *this) {
-            if (item->hash() == hash)
-                  return item;
-            }
+      ImageStoreItem* item = _hashIndex.value(hash);
+      if (item)
+            return item;
       qDebug("ImageStore::getImage(): not found <%s>", qPrintable(path));
       return 0;
       }
@@ -182,15 +248,88 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
       QCryptographicHash h(QCryptographicHash::Md4);
       h.addData(ba);
       QByteArray hash = h.result();
-      foreach(ImageStoreItem* item, *this) {
-            if (item->hash() == hash)
-                  return item;
+      ImageStoreItem* item = _hashIndex.value(hash);
+      if (item) {
+            // mark as recently used
+            if (_unused.removeOne(item))
+                  _unused.append(item);
+            return item;
             }
-      ImageStoreItem* item = new ImageStoreItem(path);
+      item = new ImageStoreItem(path);
       item->set(ba, hash);
       append(item);
+      _hashIndex.insert(hash, item);
+      // not referenced until an image is read which uses it;
+      // do not trim here, as that image may still follow
+      _unused.append(item);
+      _unusedBytes += ba.size();
       return item;
       }
 
+//---------------------------------------------------------
+//   setUsed
+//    item is referenced again
+//---------------------------------------------------------
+
+void ImageStore::setUsed(ImageStoreItem* item)
+      {
+      if (_unused.removeOne(item))
+            _unusedBytes -= item->buffer().size();
+      }
+
+//---------------------------------------------------------
+//   setUnused
+//    item is no longer referenced by any image
+//---------------------------------------------------------
+
+void ImageStore::setUnused(ImageStoreItem* item)
+      {
+      if (_unused.contains(item))
+            return;
+      _unused.append(item);
+      _unusedBytes += item->buffer().size();
+      trimUnused();
+      }
+
+//---------------------------------------------------------
+//   setUnusedLimit
+//---------------------------------------------------------
+
+void ImageStore::setUnusedLimit(qint64 bytes)
+      {
+      _unusedLimit = bytes;
+      trimUnused();
+      }
+
+//---------------------------------------------------------
+//   trimUnused
+//    delete unreferenced items, least recently used first,
+//    until they fit into the limit
+//---------------------------------------------------------
+
+void ImageStore::trimUnused()
+      {
+      while (_unusedBytes > _unusedLimit && !_unused.isEmpty()) {
+            ImageStoreItem* item = _unused.takeFirst();
+            _unusedBytes -= item->buffer().size();
+            _hashIndex.remove(item->hash());
+            removeOne(item);
+            imageCache().remove(item->hash());
+            delete item;
+            }
+      }
+
+//---------------------------------------------------------
+//   setCacheLimit
+//    set the memory limit in kB for decoded and scaled
+//    raster images; each kind gets one half
+//---------------------------------------------------------
+
+void ImageStore::setCacheLimit(int kb)
+      {
+      imageCache().setMaxCost(kb / 2);
+      pixmapCache().setMaxCost(kb / 2);
+      }
+
 }
 
@@ -39,21 +39,41 @@ class ImageStoreItem {
       bool loaded() const              { return !_buffer.isEmpty();   }
       void setPath(const QString& val);
       bool isUsed(Score*) const;
+      bool isReferenced() const        { return !_references.isEmpty(); }
       void load();
       QString hashName() const;
       const QByteArray& hash() const   { return _hash; }
       void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
+
+      QImage image() const;
+      QPixmap pixmap(const QSize&) const;
       };
 
 //---------------------------------------------------------
 //   ImageStore
+//    items are indexed by the hash of their data;
+//    items no longer referenced by any image are kept for
+//    a while (e.g. for the clipboard) and deleted, least
+//    recently used first, once they exceed a memory limit
 //---------------------------------------------------------
 
 class ImageStore : public QList<ImageStoreItem*>  {
+      QHash<QByteArray, ImageStoreItem*> _hashIndex;
+      QList<ImageStoreItem*> _unused;     // least recently used first
+      qint64 _unusedBytes { 0 };
+      qint64 _unusedLimit { 32 * 1024 * 1024 };
+
+      void trimUnused();
 
    public:
       ImageStoreItem* getImage(const QString& path) const;
       ImageStoreItem* add(const QString& path, const QByteArray&);
+
+      void setUsed(ImageStoreItem*);
+      void setUnused(ImageStoreItem*);
+      void setUnusedLimit(qint64 bytes);
+
+      static void setCacheLimit(int kb);
       };
 
 extern ImageStore imageStore;       // this is the global imageStore
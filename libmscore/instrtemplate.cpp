@@ -10,6 +10,7 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include "config.h"
 #include "instrtemplate.h"
 #include "bracket.h"
 #include "drumset.h"
@@ -26,6 +27,9 @@ QList<InstrumentGroup*> instrumentGroups;
 QList<MidiArticulation> articulation;                // global articulations
 QList<InstrumentGenre*> instrumentGenres;
 
+static QString templateCacheDir;                     // empty: no template cache
+static QString templateCacheTranslation;             // identifies the installed instruments translation
+
 //---------------------------------------------------------
 //   searchGenre
 //---------------------------------------------------------
@@ -586,12 +590,452 @@ bool saveInstrumentTemplates1(const QString& instrTemplates)
       return true;
       }
 
+//---------------------------------------------------------
+//   Instrument template cache
+//    The tables built from an instrument list are saved
+//    in a binary file and read back on the next start
+//    while the list, its translation and the cache format
+//    are unchanged. All names are stored translated.
+//---------------------------------------------------------
+
+static const quint32 TEMPLATE_CACHE_MAGIC   = 0x4d534954;   // "MSIT"
+static const qint32  TEMPLATE_CACHE_VERSION = 1;            // increment when the format changes
+
+//---------------------------------------------------------
+//   setInstrumentTemplateCache
+//    set the directory for cache files, an empty dir
+//    disables the cache
+//---------------------------------------------------------
+
+void setInstrumentTemplateCache(const QString& dir, const QString& translation)
+      {
+      templateCacheDir         = dir;
+      templateCacheTranslation = translation;
+      }
+
+//---------------------------------------------------------
+//   write/read helpers
+//---------------------------------------------------------
+
+static void writeEvents(QDataStream& s, const std::vector<MidiCoreEvent>& events)
+      {
+      s << quint32(events.size());
+      for (const MidiCoreEvent& ev : events)
+            s << quint8(ev.type()) << quint8(ev.channel()) << quint8(ev.dataA()) << quint8(ev.dataB());
+      }
+
+static void readEvents(QDataStream& s, std::vector<MidiCoreEvent>& events)
+      {
+      quint32 n;
+      s >> n;
+      events.clear();
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            quint8 type, channel, a, b;
+            s >> type >> channel >> a >> b;
+            events.push_back(MidiCoreEvent(type, channel, a, b));
+            }
+      }
+
+static void writeEventLists(QDataStream& s, const QList<NamedEventList>& l)
+      {
+      s << quint32(l.size());
+      for (const NamedEventList& nel : l) {
+            s << nel.name << nel.descr;
+            writeEvents(s, nel.events);
+            }
+      }
+
+static void readEventLists(QDataStream& s, QList<NamedEventList>& l)
+      {
+      quint32 n;
+      s >> n;
+      l.clear();
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            NamedEventList nel;
+            s >> nel.name >> nel.descr;
+            readEvents(s, nel.events);
+            l.append(nel);
+            }
+      }
+
+static void writeArticulations(QDataStream& s, const QList<MidiArticulation>& l)
+      {
+      s << quint32(l.size());
+      for (const MidiArticulation& a : l)
+            s << a.name << a.descr << qint32(a.velocity) << qint32(a.gateTime);
+      }
+
+static void readArticulations(QDataStream& s, QList<MidiArticulation>& l)
+      {
+      quint32 n;
+      s >> n;
+      l.clear();
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            MidiArticulation a;
+            qint32 velocity, gateTime;
+            s >> a.name >> a.descr >> velocity >> gateTime;
+            a.velocity = velocity;
+            a.gateTime = gateTime;
+            l.append(a);
+            }
+      }
+
+static void writeChannels(QDataStream& s, const QList<Channel>& l)
+      {
+      s << quint32(l.size());
+      for (const Channel& c : l) {
+            s << c.name << c.descr << qint32(c.channel);
+            writeEvents(s, c.init);
+            s << c.synti << qint32(c.program) << qint32(c.bank)
+              << qint8(c.volume) << qint8(c.pan) << qint8(c.chorus) << qint8(c.reverb)
+              << c.mute << c.solo << c.soloMute;
+            writeEventLists(s, c.midiActions);
+            writeArticulations(s, c.articulation);
+            }
+      }
+
+static void readChannels(QDataStream& s, QList<Channel>& l)
+      {
+      quint32 n;
+      s >> n;
+      l.clear();
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            Channel c;
+            qint32 channel, program, bank;
+            qint8 volume, pan, chorus, reverb;
+            s >> c.name >> c.descr >> channel;
+            readEvents(s, c.init);
+            s >> c.synti >> program >> bank >> volume >> pan >> chorus >> reverb
+              >> c.mute >> c.solo >> c.soloMute;
+            c.channel = channel;
+            c.program = program;
+            c.bank    = bank;
+            c.volume  = volume;
+            c.pan     = pan;
+            c.chorus  = chorus;
+            c.reverb  = reverb;
+            readEventLists(s, c.midiActions);
+            readArticulations(s, c.articulation);
+            l.append(c);
+            }
+      }
+
+static void writeStaffNames(QDataStream& s, const StaffNameList& l)
+      {
+      s << quint32(l.size());
+      for (const StaffName& sn : l)
+            s << sn.name() << qint32(sn.pos());
+      }
+
+static void readStaffNames(QDataStream& s, StaffNameList& l)
+      {
+      quint32 n;
+      s >> n;
+      l.clear();
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            QString name;
+            qint32 pos;
+            s >> name >> pos;
+            l.append(StaffName(name, pos));
+            }
+      }
+
+static void writeDrumset(QDataStream& s, const Drumset* ds)
+      {
+      for (int i = 0; i < DRUM_INSTRUMENTS; ++i) {
+            const DrumInstrument& di = ds->drum(i);
+            s << di.name << qint32(di.notehead) << qint32(di.line) << qint32(di.stemDirection)
+              << qint32(di.voice) << qint8(di.shortcut);
+            }
+      }
+
+static void readDrumset(QDataStream& s, Drumset* ds)
+      {
+      for (int i = 0; i < DRUM_INSTRUMENTS; ++i) {
+            DrumInstrument& di = ds->drum(i);
+            qint32 notehead, line, stemDirection, voice;
+            qint8 shortcut;
+            s >> di.name >> notehead >> line >> stemDirection >> voice >> shortcut;
+            di.notehead      = NoteHead::Group(notehead);
+            di.line          = line;
+            di.stemDirection = Direction(stemDirection);
+            di.voice         = voice;
+            di.shortcut      = shortcut;
+            }
+      }
+
+//---------------------------------------------------------
+//   writeTemplate
+//---------------------------------------------------------
+
+static void writeTemplate(QDataStream& s, const InstrumentTemplate* t, const QList<InstrumentGenre*>& genres)
+      {
+      s << t->id << t->trackName;
+      writeStaffNames(s, t->longNames);
+      writeStaffNames(s, t->shortNames);
+      s << t->musicXMLid << t->description << qint32(t->nstaves())
+        << qint8(t->minPitchA) << qint8(t->maxPitchA) << qint8(t->minPitchP) << qint8(t->maxPitchP)
+        << qint8(t->transpose.diatonic) << qint8(t->transpose.chromatic)
+        << qint32(t->staffGroup) << (t->staffTypePreset ? t->staffTypePreset->xmlName() : QString())
+        << t->useDrumset << bool(t->drumset);
+      if (t->drumset)
+            writeDrumset(s, t->drumset);
+
+      QList<instrString> strings = t->stringData.stringList();
+      s << qint32(t->stringData.frets()) << quint32(strings.size());
+      for (const instrString& str : strings)
+            s << qint32(str.pitch) << str.open;
+
+      writeEventLists(s, t->midiActions);
+      writeArticulations(s, t->articulation);
+      writeChannels(s, t->channel);
+      s << quint32(t->genres.size());
+      for (InstrumentGenre* g : t->genres)
+            s << qint32(genres.indexOf(g));
+
+      for (int i = 0; i < MAX_STAVES; ++i) {
+            s << qint32(t->clefTypes[i]._concertClef) << qint32(t->clefTypes[i]._transposingClef)
+              << qint32(t->staffLines[i]) << qint32(t->bracket[i]) << qint32(t->bracketSpan[i])
+              << qint32(t->barlineSpan[i]) << t->smallStaff[i];
+            }
+      s << t->extended;
+      }
+
+//---------------------------------------------------------
+//   readTemplate
+//---------------------------------------------------------
+
+static InstrumentTemplate* readTemplate(QDataStream& s, const QList<InstrumentGenre*>& genres)
+      {
+      InstrumentTemplate* t = new InstrumentTemplate;
+      qint32 staves, staffGroup;
+      qint8 minPitchA, maxPitchA, minPitchP, maxPitchP, diatonic, chromatic;
+      QString presetName;
+      bool hasDrumset;
+
+      s >> t->id >> t->trackName;
+      readStaffNames(s, t->longNames);
+      readStaffNames(s, t->shortNames);
+      s >> t->musicXMLid >> t->description >> staves
+        >> minPitchA >> maxPitchA >> minPitchP >> maxPitchP
+        >> diatonic >> chromatic
+        >> staffGroup >> presetName
+        >> t->useDrumset >> hasDrumset;
+      t->setStaves(staves);
+      t->minPitchA           = minPitchA;
+      t->maxPitchA           = maxPitchA;
+      t->minPitchP           = minPitchP;
+      t->maxPitchP           = maxPitchP;
+      t->transpose.diatonic  = diatonic;
+      t->transpose.chromatic = chromatic;
+      t->staffGroup          = StaffGroup(staffGroup);
+      t->staffTypePreset     = presetName.isEmpty() ? 0 : StaffType::presetFromXmlName(presetName);
+      if (hasDrumset) {
+            t->drumset = new Drumset;
+            readDrumset(s, t->drumset);
+            }
+
+      qint32 frets;
+      quint32 nstrings;
+      s >> frets >> nstrings;
+      QList<instrString> strings;
+      for (quint32 i = 0; i < nstrings && s.status() == QDataStream::Ok; ++i) {
+            qint32 pitch;
+            bool open;
+            s >> pitch >> open;
+            strings.append(instrString { pitch, open });
+            }
+      t->stringData = StringData(frets, strings);
+
+      readEventLists(s, t->midiActions);
+      readArticulations(s, t->articulation);
+      readChannels(s, t->channel);
+      quint32 ngenres;
+      s >> ngenres;
+      for (quint32 i = 0; i < ngenres && s.status() == QDataStream::Ok; ++i) {
+            qint32 idx;
+            s >> idx;
+            if (idx >= 0 && idx < genres.size())
+                  t->genres.append(genres[idx]);
+            }
+
+      for (int i = 0; i < MAX_STAVES; ++i) {
+            qint32 concertClef, transposingClef, staffLines, bracket, bracketSpan, barlineSpan;
+            s >> concertClef >> transposingClef >> staffLines >> bracket >> bracketSpan >> barlineSpan
+              >> t->smallStaff[i];
+            t->clefTypes[i]._concertClef     = ClefType(concertClef);
+            t->clefTypes[i]._transposingClef = ClefType(transposingClef);
+            t->staffLines[i]  = staffLines;
+            t->bracket[i]     = BracketType(bracket);
+            t->bracketSpan[i] = bracketSpan;
+            t->barlineSpan[i] = barlineSpan;
+            }
+      s >> t->extended;
+      return t;
+      }
+
+extern QString revision;
+
+//---------------------------------------------------------
+//   templateCacheKey
+//    everything the cached tables depend on, including the
+//    build which parsed and wrote them; without a known
+//    revision the time stamp of the executable is used
+//---------------------------------------------------------
+
+static QString templateCacheKey(const QFileInfo& fi)
+      {
+      QString build = revision;
+      if (build.isEmpty())
+            build = QString::number(QFileInfo(QCoreApplication::applicationFilePath()).lastModified().toMSecsSinceEpoch());
+      return QString("%1|%2|%3|%4|%5|%6").arg(fi.absoluteFilePath())
+         .arg(fi.size())
+         .arg(fi.lastModified().toMSecsSinceEpoch())
+         .arg(VERSION)
+         .arg(build)
+         .arg(templateCacheTranslation);
+      }
+
+//---------------------------------------------------------
+//   templateCachePath
+//---------------------------------------------------------
+
+static QString templateCachePath(const QFileInfo& fi)
+      {
+      return QString("%1/%2-%3.cache").arg(templateCacheDir)
+         .arg(fi.completeBaseName())
+         .arg(qHash(fi.absoluteFilePath()), 0, 16);
+      }
+
+//---------------------------------------------------------
+//   writeTemplateCache
+//---------------------------------------------------------
+
+static void writeTemplateCache(const QString& path, const QString& key)
+      {
+      QDir().mkpath(QFileInfo(path).absolutePath());
+      QSaveFile f(path);
+      if (!f.open(QIODevice::WriteOnly)) {
+            qDebug("cannot write instrument template cache <%s>", qPrintable(path));
+            return;
+            }
+      QDataStream s(&f);
+      s.setVersion(QDataStream::Qt_5_0);
+      s << TEMPLATE_CACHE_MAGIC << TEMPLATE_CACHE_VERSION << key;
+
+      s << quint32(instrumentGenres.size());
+      for (const InstrumentGenre* genre : instrumentGenres)
+            s << genre->id << genre->name;
+      writeArticulations(s, articulation);
+      s << quint32(instrumentGroups.size());
+      for (const InstrumentGroup* group : instrumentGroups) {
+            s << group->id << group->name << group->extended << quint32(group->instrumentTemplates.size());
+            for (const InstrumentTemplate* t : group->instrumentTemplates)
+                  writeTemplate(s, t, instrumentGenres);
+            }
+      if (s.status() != QDataStream::Ok || !f.commit())
+            qDebug("cannot write instrument template cache <%s>", qPrintable(path));
+      }
+
+//---------------------------------------------------------
+//   readTemplateCache
+//    the file is mapped and read in one pass; the global
+//    tables are only set if the whole cache is valid
+//---------------------------------------------------------
+
+static bool readTemplateCache(const QString& path, const QString& key)
+      {
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly))
+            return false;
+      uchar* data = f.map(0, f.size());
+      if (!data)
+            return false;
+      QByteArray ba = QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(f.size()));
+      QDataStream s(ba);
+      s.setVersion(QDataStream::Qt_5_0);
+
+      quint32 magic;
+      qint32 version;
+      QString cacheKey;
+      s >> magic >> version;
+      if (magic != TEMPLATE_CACHE_MAGIC || version != TEMPLATE_CACHE_VERSION)
+            return false;
+      s >> cacheKey;
+      if (cacheKey != key)
+            return false;
+
+      QList<InstrumentGenre*> genres;
+      QList<MidiArticulation> articulations;
+      QList<InstrumentGroup*> groups;
+
+      quint32 n;
+      s >> n;
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            InstrumentGenre* genre = new InstrumentGenre;
+            s >> genre->id >> genre->name;
+            genres.append(genre);
+            }
+      readArticulations(s, articulations);
+      s >> n;
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            InstrumentGroup* group = new InstrumentGroup;
+            quint32 ntemplates;
+            s >> group->id >> group->name >> group->extended >> ntemplates;
+            for (quint32 k = 0; k < ntemplates && s.status() == QDataStream::Ok; ++k)
+                  group->instrumentTemplates.append(readTemplate(s, genres));
+            groups.append(group);
+            }
+
+      if (s.status() != QDataStream::Ok || !s.atEnd()) {
+            qDebug("instrument template cache <%s> is corrupt", qPrintable(path));
+            for (InstrumentGroup* group : groups)
+                  qDeleteAll(group->instrumentTemplates);
+            qDeleteAll(groups);
+            qDeleteAll(genres);
+            return false;
+            }
+      instrumentGenres = genres;
+      articulation     = articulations;
+      instrumentGroups = groups;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   clearInstrumentTemplates
+//---------------------------------------------------------
+
+void clearInstrumentTemplates()
+      {
+      for (InstrumentGroup* group : instrumentGroups)
+            qDeleteAll(group->instrumentTemplates);
+      qDeleteAll(instrumentGroups);
+      instrumentGroups.clear();
+      qDeleteAll(instrumentGenres);
+      instrumentGenres.clear();
+      articulation.clear();
+      }
+
 //---------------------------------------------------------
 //   loadInstrumentTemplates
 //---------------------------------------------------------
 
 bool loadInstrumentTemplates(const QString& instrTemplates)
       {
+      // The cache holds the complete tables, so it is only used
+      // for the first list of a cascade. Resources never change.
+      QFileInfo fi(instrTemplates);
+      bool useCache = !templateCacheDir.isEmpty() && !instrTemplates.startsWith(":")
+         && instrumentGroups.isEmpty() && instrumentGenres.isEmpty() && articulation.isEmpty();
+      QString cachePath;
+      QString cacheKey;
+      if (useCache) {
+            cachePath = templateCachePath(fi);
+            cacheKey  = templateCacheKey(fi);
+            if (readTemplateCache(cachePath, cacheKey))
+                  return true;
+            }
+
       QFile qf(instrTemplates);
       if (!qf.open(QIODevice::Text | QIODevice::ReadOnly)) {
             qDebug("cannot load instrument templates at <%s>", qPrintable(instrTemplates));
@@ -633,6 +1077,8 @@ bool loadInstrumentTemplates(const QString& instrTemplates)
                   }
             }
       // saveInstrumentTemplates1("/home/ws/mops.xml");
+      if (useCache)
+            writeTemplateCache(cachePath, cacheKey);
       return true;
       }
 
@@ -118,6 +118,8 @@ struct InstrumentGroup {
 extern QList<InstrumentGenre *> instrumentGenres;
 extern QList<InstrumentGroup*> instrumentGroups;
 extern bool loadInstrumentTemplates(const QString& instrTemplates);
+extern void clearInstrumentTemplates();
+extern void setInstrumentTemplateCache(const QString& dir, const QString& translation);
 extern bool saveInstrumentTemplates(const QString& instrTemplates);
 extern InstrumentTemplate* searchTemplate(const QString& name);
 
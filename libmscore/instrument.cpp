@@ -656,7 +656,7 @@ void MidiArticulation::read(XmlReader& e)
 //   updateVelocity
 //---------------------------------------------------------
 
-void Instrument::updateVelocity(int* velocity, int /*channelIdx*/, const QString& name)
+void Instrument::updateVelocity(int* velocity, int /*channelIdx*/, const QString& name) const
       {
       for (const MidiArticulation& a : _articulation) {
             if (a.name == name) {
@@ -670,7 +670,7 @@ void Instrument::updateVelocity(int* velocity, int /*channelIdx*/, const QString
 //   updateGateTime
 //---------------------------------------------------------
 
-void Instrument::updateGateTime(int* gateTime, int /*channelIdx*/, const QString& name)
+void Instrument::updateGateTime(int* gateTime, int /*channelIdx*/, const QString& name) const
       {
       for (const MidiArticulation& a : _articulation) {
             if (a.name == name) {
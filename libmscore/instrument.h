@@ -159,8 +159,8 @@ class Instrument {
       void write(XmlWriter& xml, Part *part) const;
       NamedEventList* midiAction(const QString& s, int channel) const;
       int channelIdx(const QString& s) const;
-      void updateVelocity(int* velocity, int channel, const QString& name);
-      void updateGateTime(int* gateTime, int channelIdx, const QString& name);
+      void updateVelocity(int* velocity, int channel, const QString& name) const;
+      void updateGateTime(int* gateTime, int channelIdx, const QString& name) const;
 
       bool operator==(const Instrument&) const;
 
@@ -2997,12 +2997,36 @@ System* Score::collectSystem(LayoutContext& lc)
 //      if (lineMode())
             system->setWidth(pos.x());
 
+      layoutSystemElements(system, system->measures());
+      system->layout2();   // compute staff distances
+
+      Measure* lm  = system->lastMeasure();
+      if (lm) {
+            lc.firstSystem        = lm->sectionBreak() && _layoutMode != LayoutMode::FLOAT;
+            lc.startWithLongNames = lc.firstSystem && lm->sectionBreakElement()->startWithLongNames();
+            }
+      return system;
+      }
+
+//---------------------------------------------------------
+//   layoutSystemElements
+//    layout beams, ties, annotations, lyrics and spanners
+//    for the measures ml of system; ml must be the
+//    complete measure list of system or a contiguous
+//    part of it
+//---------------------------------------------------------
+
+void Score::layoutSystemElements(System* system, const std::vector<MeasureBase*>& ml)
+      {
+      Measure* fm    = system->firstMeasure();
+      int systemTick = fm ? fm->tick() : 0;
+
       //
       // compute measure shape
       //
 
       for (int si = 0; si < score()->nstaves(); ++si) {
-            for (MeasureBase* mb : system->measures()) {
+            for (MeasureBase* mb : ml) {
                   if (!mb->isMeasure())
                         continue;
                   Measure* m = toMeasure(mb);
@@ -3028,7 +3052,7 @@ System* Score::collectSystem(LayoutContext& lc)
       //
       int stick = -1;
       int etick;
-      for (MeasureBase* mb : system->measures()) {
+      for (MeasureBase* mb : ml) {
             if (!mb->isMeasure())
                   continue;
             SegmentType st = SegmentType::ChordRest;
@@ -3056,7 +3080,7 @@ System* Score::collectSystem(LayoutContext& lc)
                                                 }
                                           if (note->tieBack()) {
                                                 Tie* tie = toTie(note->tieBack());
-                                                if (tie->startNote()->tick() < stick)
+                                                if (tie->startNote()->tick() < systemTick)
                                                       tie->layoutBack(system);
                                                 }
                                           }
@@ -3113,7 +3137,7 @@ System* Score::collectSystem(LayoutContext& lc)
 
       switch (ar) {
             case VerticalAlignRange::MEASURE:
-                  for (MeasureBase* mb : system->measures()) {
+                  for (MeasureBase* mb : ml) {
                         if (!mb->isMeasure())
                               continue;
                         Measure* m = toMeasure(mb);
@@ -3124,16 +3148,24 @@ System* Score::collectSystem(LayoutContext& lc)
                         }
                   break;
             case VerticalAlignRange::SYSTEM:
+                  // the alignment spans the whole system; measures not laid out
+                  // again contribute the extent found by their last layout
                   for (int staffIdx = system->firstVisibleStaff(); staffIdx < nstaves(); staffIdx = system->nextVisibleStaff(staffIdx)) {
+                        for (MeasureBase* mb : ml) {
+                              if (!mb->isMeasure())
+                                    continue;
+                              Measure* m = toMeasure(mb);
+                              m->setLyricsExtent(staffIdx, findLyricsMinY(m, staffIdx), findLyricsMaxY(m, staffIdx));
+                              }
                         qreal yMax = 0.0;
                         qreal yMin = 0.0;
                         for (MeasureBase* mb : system->measures()) {
                               if (!mb->isMeasure())
                                     continue;
-                              yMax = qMax(yMax, findLyricsMaxY(toMeasure(mb), staffIdx));
-                              yMin = qMin(yMin, findLyricsMinY(toMeasure(mb), staffIdx));
+                              yMax = qMax(yMax, toMeasure(mb)->lyricsMaxY(staffIdx));
+                              yMin = qMin(yMin, toMeasure(mb)->lyricsMinY(staffIdx));
                               }
-                        for (MeasureBase* mb : system->measures()) {
+                        for (MeasureBase* mb : ml) {
                               if (!mb->isMeasure())
                                     continue;
                               applyLyricsMax(toMeasure(mb), staffIdx, yMax);
@@ -3142,7 +3174,7 @@ System* Score::collectSystem(LayoutContext& lc)
                         }
                   break;
             case VerticalAlignRange::SEGMENT:
-                  for (MeasureBase* mb : system->measures()) {
+                  for (MeasureBase* mb : ml) {
                         if (!mb->isMeasure())
                               continue;
                         Measure* m = toMeasure(mb);
@@ -3194,7 +3226,7 @@ System* Score::collectSystem(LayoutContext& lc)
             // add SpannerSegment shapes to staff shapes
             //
 
-            for (MeasureBase* mb : system->measures()) {
+            for (MeasureBase* mb : ml) {
                   if (!mb->isMeasure())
                         continue;
                   Measure* m = toMeasure(mb);
@@ -3233,7 +3265,7 @@ System* Score::collectSystem(LayoutContext& lc)
             // add ottava shapes to staff shapes
             //
 
-            for (MeasureBase* mb : system->measures()) {
+            for (MeasureBase* mb : ml) {
                   if (!mb->isMeasure())
                         continue;
                   Measure* m = toMeasure(mb);
@@ -3253,7 +3285,7 @@ System* Score::collectSystem(LayoutContext& lc)
 
       // tempo text
 
-      for (MeasureBase* mb : system->measures()) {
+      for (MeasureBase* mb : ml) {
             if (!mb->isMeasure())
                   continue;
             SegmentType st = SegmentType::ChordRest;
@@ -3273,14 +3305,62 @@ System* Score::collectSystem(LayoutContext& lc)
                         }
                   }
             }
-      system->layout2();   // compute staff distances
+      }
 
-      Measure* lm  = system->lastMeasure();
-      if (lm) {
-            lc.firstSystem        = lm->sectionBreak() && _layoutMode != LayoutMode::FLOAT;
-            lc.startWithLongNames = lc.firstSystem && lm->sectionBreakElement()->startWithLongNames();
+//---------------------------------------------------------
+//   layoutPageMeasure
+//    layout elements of measure m which depend on the
+//    final position of the system (cross staff beams,
+//    ties, glissandi, arpeggios, bar lines)
+//---------------------------------------------------------
+
+static void layoutPageMeasure(Measure* m)
+      {
+      Score* score = m->score();
+      for (int track = 0; track < score->ntracks(); ++track) {
+            for (Segment* segment = m->first(); segment; segment = segment->next()) {
+                  Element* e = segment->element(track);
+                  if (!e)
+                        continue;
+                  if (e->isChordRest()) {
+                        if (!score->staff(track2staff(track))->show())
+                              continue;
+                        ChordRest* cr = toChordRest(e);
+                        if (notTopBeam(cr))                   // layout cross staff beams
+                              cr->beam()->layout();
+
+                        if (cr->isChord()) {
+                              Chord* c = toChord(cr);
+                              for (Chord* cc : c->graceNotes()) {
+                                    if (cc->beam() && cc->beam()->elements().front() == cc)
+                                          cc->beam()->layout();
+                                    for (Note* n : cc->notes()) {
+                                          Tie* tie = n->tieFor();
+                                          if (tie)
+                                                tie->layout();
+                                          for (Spanner* sp : n->spannerFor())
+                                                sp->layout();
+                                          }
+                                    for (Element* e : cc->el()) {
+                                          if (e->isSlur())
+                                                e->layout();
+                                          }
+                                    }
+                              c->layoutArpeggio2();
+                              for (Note* n : c->notes()) {
+                                    Tie* tie = n->tieFor();
+                                    if (tie)
+                                          tie->layout();
+                                    for (Spanner* sp : n->spannerFor())
+                                          sp->layout();
+                                    }
+                              }
+                        }
+                  else if (e->isBarLine())
+                        toBarLine(e)->layout2();
+                  }
             }
-      return system;
+      m->layout2();
       }
 
 //---------------------------------------------------------
@@ -3400,64 +3480,251 @@ void LayoutContext::collectPage()
                   }
             }
 
-      int stick = -1;
       for (System* s : page->systems()) {
-            Score* score = s->score();
             for (MeasureBase* mb : s->measures()) {
-                  if (!mb->isMeasure())
-                        continue;
+                  if (mb->isMeasure())
+                        layoutPageMeasure(toMeasure(mb));
+                  }
+            }
+//      printf("%p ====set rebuild\n", page);
+//      page->rebuildBspTree();
+      }
+
+//---------------------------------------------------------
+//   measureEndX
+//    x position following mb in its system
+//---------------------------------------------------------
+
+static qreal measureEndX(MeasureBase* mb)
+      {
+      qreal x = mb->x() + mb->width();
+      if (mb->isHBox())
+            x -= toHBox(mb)->topGap();
+      return x;
+      }
+
+//---------------------------------------------------------
+//   hasLyrics
+//    true if a chord or rest of m has lyrics or the last
+//    layout of m found lyrics to align
+//---------------------------------------------------------
+
+static bool hasLyrics(Score* score, Measure* m)
+      {
+      for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            if (m->lyricsMinY(staffIdx) != 0.0 || m->lyricsMaxY(staffIdx) != 0.0)
+                  return true;
+            }
+      for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            for (Element* e : s->elist()) {
+                  if (e && !toChordRest(e)->lyrics().empty())
+                        return true;
+                  }
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   layoutLinearRange
+//    incremental layout for LayoutMode::LINE
+//    Only a window of measures around stick - etick is
+//    laid out again. All other measures keep their cached
+//    width and are only moved by the width difference
+//    of the window.
+//    Returns false if the system does not match the
+//    measure list anymore or the window has lyrics which
+//    are aligned over the whole system, a full layout is
+//    needed then.
+//---------------------------------------------------------
+
+bool Score::layoutLinearRange(int stick, int etick)
+      {
+      if (_systems.size() != 1 || pages().size() != 1 || styleB(StyleIdx::hideEmptyStaves))
+            return false;
+      System* system = _systems.front();
+      Page* page     = pages().front();
+      if (page->systems().size() != 1 || page->systems().front() != system)
+            return false;
+
+      //
+      // check that the system still holds exactly the measures
+      // collectSystem() would collect and locate the edited range
+      //
+      std::vector<MeasureBase*>& ml = system->measures();
+      int n  = int(ml.size());
+      int i  = 0;
+      int i1 = -1;
+      int i2 = -1;
+      for (MeasureBase* mb = _showVBox ? first() : firstMeasure(); mb; mb = _showVBox ? mb->next() : mb->nextMeasure()) {
+            if (mb->isVBox())
+                  continue;
+            if (i >= n || ml[i] != mb)
+                  return false;
+            if (i1 == -1 && mb->endTick() > stick)
+                  i1 = i;
+            if (i2 == -1 && mb->endTick() > etick)
+                  i2 = i;
+            ++i;
+            }
+      if (i != n || i1 == -1)
+            return false;
+      if (i2 == -1)
+            i2 = n - 1;
+      // add one measure of context on both sides, as doLayoutRange() does
+      // to handle clefs, cautionary elements and barlines
+      i1 = qMax(i1 - 1, 0);
+      i2 = qMin(i2 + 1, n - 1);
+
+      // lyrics aligned over the whole system may move in all
+      // measures, decide before anything is changed
+      if (VerticalAlignRange(styleI(StyleIdx::autoplaceVerticalAlignRange)) == VerticalAlignRange::SYSTEM) {
+            for (int k = i1; k <= i2; ++k) {
+                  if (ml[k]->isMeasure() && hasLyrics(this, toMeasure(ml[k])))
+                        return false;
+                  }
+            }
+
+      MeasureBase* fmb = ml[i1];
+      MeasureBase* lmb = ml[i2];
+      qreal oldEndX    = measureEndX(lmb);
+      Measure* fm      = system->firstMeasure();
+      Measure* lm      = system->lastMeasure();
+
+      LayoutContext lc;
+      lc.score       = this;
+      lc.endTick     = etick;
+      lc.curMeasure  = i1 > 0 ? ml[i1-1] : 0;
+      lc.nextMeasure = fmb;
+      lc.measureNo   = fmb->no() - fmb->noOffset();
+      lc.tick        = fmb->tick();
+      if (Measure* pm = fmb->prevMeasure())
+            lc.sig = pm->len();
+
+      //
+      // relayout the measures of the window
+      //
+      std::vector<MeasureBase*> window;
+      bool createHeader = i1 > 0 && ml[i1-1]->isHBox() && toHBox(ml[i1-1])->createSystemHeader();
+      for (int k = i1; k <= i2; ++k) {
+            getNextMeasure(lc);
+            MeasureBase* mb = lc.curMeasure;
+            window.push_back(mb);
+            if (mb->isMeasure()) {
                   Measure* m = toMeasure(mb);
-                  if (stick == -1)
-                        stick = m->tick();
+                  if (m == fm) {
+                        system->layoutSystem(0.0);
+                        m->addSystemHeader(true);
+                        }
+                  else if (createHeader)
+                        m->addSystemHeader(false);
+                  else if (m->header())
+                        m->removeSystemHeader();
+                  createHeader = false;
+                  if (m->repeatStart()) {
+                        Segment* s = m->findSegmentR(SegmentType::StartRepeatBarLine, 0);
+                        if (!s->enabled())
+                              s->setEnabled(true);
+                        }
+                  if (m->trailer())
+                        m->removeSystemTrailer();
+                  m->createEndBarLines(m == lm);
+                  m->computeMinWidth();
+                  }
+            else if (mb->isHBox()) {
+                  mb->computeMinWidth();
+                  createHeader = toHBox(mb)->createSystemHeader();
+                  }
+            }
 
-                  for (int track = 0; track < score->ntracks(); ++track) {
-                        for (Segment* segment = m->first(); segment; segment = segment->next()) {
-                              Element* e = segment->element(track);
-                              if (!e)
-                                    continue;
-                              if (e->isChordRest()) {
-                                    if (!score->staff(track2staff(track))->show())
-                                          continue;
-                                    ChordRest* cr = toChordRest(e);
-                                    if (notTopBeam(cr))                   // layout cross staff beams
-                                          cr->beam()->layout();
-
-                                    if (cr->isChord()) {
-                                          Chord* c = toChord(cr);
-                                          for (Chord* cc : c->graceNotes()) {
-                                                if (cc->beam() && cc->beam()->elements().front() == cc)
-                                                      cc->beam()->layout();
-                                                for (Note* n : cc->notes()) {
-                                                      Tie* tie = n->tieFor();
-                                                      if (tie)
-                                                            tie->layout();
-                                                      for (Spanner* sp : n->spannerFor())
-                                                            sp->layout();
-                                                      }
-                                                for (Element* e : cc->el()) {
-                                                      if (e->isSlur())
-                                                            e->layout();
-                                                      }
-                                                }
-                                          c->layoutArpeggio2();
-                                          for (Note* n : c->notes()) {
-                                                Tie* tie = n->tieFor();
-                                                if (tie)
-                                                      tie->layout();
-                                                for (Spanner* sp : n->spannerFor())
-                                                      sp->layout();
-                                                }
-                                          }
-                                    }
-                              else if (e->isBarLine())
-                                    toBarLine(e)->layout2();
+      // measure numbers and ticks of the following measures must not change
+      if (i2 + 1 < n) {
+            MeasureBase* nmb = ml[i2+1];
+            if (nmb->tick() != lc.tick || nmb->no() != lc.measureNo + nmb->noOffset())
+                  return false;
+            }
+
+      QPointF pos(i1 > 0 ? measureEndX(ml[i1-1]) : 0.0, 0.0);
+      for (MeasureBase* mb : window) {
+            qreal ww = mb->width();
+            if (mb->isMeasure()) {
+                  if (mb == fm)
+                        pos.rx() += system->leftMargin();
+                  mb->setPos(pos);
+                  Measure* m = toMeasure(mb);
+                  m->stretchMeasure(ww);
+                  m->layoutStaffLines();
+                  }
+            else if (mb->isHBox()) {
+                  mb->setPos(pos + QPointF(toHBox(mb)->topGap(), 0.0));
+                  mb->layout();
+                  }
+            pos.rx() += ww;
+            }
+
+      //
+      // move all following measures and spanner segments
+      //
+      int wstick = fmb->tick();
+      int wetick = lmb->endTick();
+      qreal dx   = pos.x() - oldEndX;
+      if (dx != 0.0) {
+            for (int k = i2 + 1; k < n; ++k)
+                  ml[k]->rxpos() += dx;
+            for (SpannerSegment* ss : system->spannerSegments()) {
+                  if (ss->spanner()->tick() >= wetick)
+                        ss->rxpos() += dx;
+                  }
+            system->setWidth(system->width() + dx);
+            }
+
+      // detach segments of spanners crossing the window so
+      // that layoutSystemElements() can reuse them
+      auto spanners = spannerMap().findOverlapping(wstick, wetick);
+      for (auto interval : spanners) {
+            Spanner* sp = interval.value;
+            if (sp->tick() < wetick && sp->tick2() > wstick) {
+                  for (SpannerSegment* ss : sp->spannerSegments()) {
+                        if (ss->system() == system)
+                              ss->setSystem(0);
+                        }
+                  }
+            }
+
+      layoutSystemElements(system, window);
+
+      //
+      // system relative elements of the following measures
+      // only need to follow the move
+      //
+      if (dx != 0.0) {
+            for (int k = i2 + 1; k < n; ++k) {
+                  if (!ml[k]->isMeasure())
+                        continue;
+                  Measure* m = toMeasure(ml[k]);
+                  for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+                        for (Element* e : s->elist()) {
+                              if (e && e->isChordRest() && isTopBeam(toChordRest(e)))
+                                    toChordRest(e)->beam()->layout();
                               }
                         }
-                  m->layout2();
+                  }
+            for (Spanner* sp : _unmanagedSpanner) {
+                  if (sp->tick2() >= wstick)
+                        sp->layout();
                   }
             }
-//      printf("%p ====set rebuild\n", page);
-//      page->rebuildBspTree();
+      system->layout2();   // compute staff distances
+
+      int k2 = dx != 0.0 ? n - 1 : i2;
+      for (int k = i1 > 0 ? i1 - 1 : 0; k <= k2; ++k) {
+            if (ml[k]->isMeasure())
+                  layoutPageMeasure(toMeasure(ml[k]));
+            }
+      page->rebuildBspTree();
+
+      for (MuseScoreView* v : viewer)
+            v->layoutChanged();
+      return true;
       }
 
 //---------------------------------------------------------
@@ -3473,6 +3740,47 @@ void Score::doLayout()
       doLayoutRange(0, -1);
       }
 
+//---------------------------------------------------------
+//   deferLayoutRange
+//    remember a range to be laid out later, merged with
+//    any range still pending
+//---------------------------------------------------------
+
+void Score::deferLayoutRange(int stick, int etick, LayoutFlags flags)
+      {
+      if (stick < 0)
+            stick = 0;
+      if (_layoutPending) {
+            stick = qMin(stick, _pendingStartTick);
+            if (etick >= 0 && _pendingEndTick >= 0)
+                  etick = qMax(etick, _pendingEndTick);
+            else
+                  etick = -1;
+            flags |= _pendingLayoutFlags;
+            }
+      _layoutPending      = true;
+      _pendingStartTick   = stick;
+      _pendingEndTick     = etick;
+      _pendingLayoutFlags = flags;
+      }
+
+//---------------------------------------------------------
+//   doPendingLayout
+//    lay out the range collected by deferLayoutRange()
+//---------------------------------------------------------
+
+void Score::doPendingLayout()
+      {
+      if (!_layoutPending)
+            return;
+      _layoutPending = false;
+      CmdState& cs = cmdState();
+      LayoutFlags flags = cs.layoutFlags;
+      cs.layoutFlags |= _pendingLayoutFlags;
+      doLayoutRange(_pendingStartTick, _pendingEndTick);
+      cs.layoutFlags = flags;
+      }
+
 //---------------------------------------------------------
 //   doLayoutRange
 //---------------------------------------------------------
@@ -3490,8 +3798,6 @@ qDebug("%p %d-%d %s systems %d", this, stick, etick, isMaster() ? "Master" : "Pa
       if (etick < 0)
             etick = lastMeasure()->endTick();
 
-      LayoutContext lc;
-      lc.endTick     = etick;
       _scoreFont     = ScoreFont::fontFactory(style().value(StyleIdx::MusicalSymbolFont).toString());
       _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
@@ -3500,6 +3806,12 @@ qDebug("%p %d-%d %s systems %d", this, stick, etick, isMaster() ? "Master" : "Pa
       if (cmdState().layoutFlags & LayoutFlag::PLAY_EVENTS)
             createPlayEvents();
 
+      if (lineMode() && !layoutAll && layoutLinearRange(stick, etick))
+            return;
+
+      LayoutContext lc;
+      lc.endTick     = etick;
+
       //---------------------------------------------------
       //    initialize layout context lc
       //---------------------------------------------------
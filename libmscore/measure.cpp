@@ -96,6 +96,8 @@ class MStaff {
                                           ///< this changes some layout rules
       bool _visible         { true  };
       bool _slashStyle      { false };
+      qreal _lyricsMinY     { 0.0 };      ///< lyrics extent found by the last layout of the measure
+      qreal _lyricsMaxY     { 0.0 };
 #ifndef NDEBUG
       bool _corrupted       { false };
 #endif
@@ -131,6 +133,10 @@ class MStaff {
       bool slashStyle() const        { return _slashStyle; }
       void setSlashStyle(bool val)   { _slashStyle = val;  }
 
+      qreal lyricsMinY() const       { return _lyricsMinY; }
+      qreal lyricsMaxY() const       { return _lyricsMaxY; }
+      void setLyricsExtent(qreal yMin, qreal yMax) { _lyricsMinY = yMin; _lyricsMaxY = yMax; }
+
 #ifndef NDEBUG
       bool corrupted() const         { return _corrupted; }
       void setCorrupted(bool val)    { _corrupted = val; }
@@ -296,6 +302,9 @@ void Measure::setNoText(int staffIdx, Text* t)                  { _mstaves[staff
 Text* Measure::noText(int staffIdx) const                       { return _mstaves[staffIdx]->noText(); }
 Shape Measure::staffShape(int staffIdx) const                   { return _mstaves[staffIdx]->shape(); }
 Shape& Measure::staffShape(int staffIdx)                        { return _mstaves[staffIdx]->shape(); }
+qreal Measure::lyricsMinY(int staffIdx) const                   { return _mstaves[staffIdx]->lyricsMinY(); }
+qreal Measure::lyricsMaxY(int staffIdx) const                   { return _mstaves[staffIdx]->lyricsMaxY(); }
+void Measure::setLyricsExtent(int staffIdx, qreal yMin, qreal yMax) { _mstaves[staffIdx]->setLyricsExtent(yMin, yMax); }
 
 //---------------------------------------------------------
 //   Measure
@@ -855,7 +864,7 @@ void Measure::add(Element* e)
                   break;
 
             case ElementType::MEASURE:
-                  _mmRest = toMeasure(e);
+                  setMMRest(toMeasure(e));
                   break;
 
             default:
@@ -935,7 +944,7 @@ void Measure::remove(Element* e)
                   break;
 
             case ElementType::MEASURE:
-                  _mmRest = 0;
+                  setMMRest(0);
                   break;
 
             default:
@@ -2903,6 +2912,16 @@ Measure* Measure::mmRestLast() const
       return score()->lastMeasure();
       }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+      {
+      _mmRest = m;
+      score()->invalidateTickIndex();
+      }
+
 //---------------------------------------------------------
 //   mmRest1
 //    return the multi measure rest this measure is covered
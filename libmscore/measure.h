@@ -132,6 +132,9 @@ class Measure : public MeasureBase {
       Text* noText(int staffIdx) const;
       Shape staffShape(int staffIdx) const;
       Shape& staffShape(int staffIdx);
+      qreal lyricsMinY(int staffIdx) const;
+      qreal lyricsMaxY(int staffIdx) const;
+      void setLyricsExtent(int staffIdx, qreal yMin, qreal yMax);
       void createStaves(int);
 
       MeasureNumberMode measureNumberMode() const     { return _noMode;      }
@@ -242,7 +245,7 @@ class Measure : public MeasureBase {
       bool isMMRest() const         { return _mmRestCount > 0; }
       Measure* mmRest() const       { return _mmRest;      }
       const Measure* mmRest1() const;
-      void setMMRest(Measure* m)    { _mmRest = m;         }
+      void setMMRest(Measure* m);
       int mmRestCount() const       { return _mmRestCount; }    // number of measures _mmRest spans
       void setMMRestCount(int n)    { _mmRestCount = n;    }
       Measure* mmRestFirst() const;
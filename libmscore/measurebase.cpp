@@ -206,6 +206,18 @@ Measure* MeasureBase::nextMeasure() const
       return toMeasure(m);
       }
 
+//---------------------------------------------------------
+//   setTick
+//---------------------------------------------------------
+
+void MeasureBase::setTick(int t)
+      {
+      if (_tick != t) {
+            _tick = t;
+            score()->invalidateTickIndex();
+            }
+      }
+
 //---------------------------------------------------------
 //   nextMeasureMM
 //---------------------------------------------------------
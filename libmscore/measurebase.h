@@ -130,7 +130,7 @@ class MeasureBase : public Element {
       virtual int tick() const override      { return _tick;  }
       virtual int ticks() const              { return 0;      }
       int endTick() const                    { return tick() + ticks();  }
-      void setTick(int t)                    { _tick = t;     }
+      void setTick(int t);
 
       qreal pause() const;
 
@@ -101,6 +101,9 @@ qreal   MScore::nudgeStep;
 qreal   MScore::nudgeStep10;
 qreal   MScore::nudgeStep50;
 int     MScore::defaultPlayDuration;
+int     MScore::undoMemoryLimit;
+int     MScore::imageCacheLimit;
+int     MScore::unusedImageLimit;
 
 QString MScore::lastError;
 int     MScore::division    = 480; // 3840;   // pulses per quarter note (PPQ) // ticks per beat
@@ -109,6 +112,8 @@ int     MScore::mtcType;
 
 bool    MScore::noExcerpts = false;
 bool    MScore::noImages = false;
+bool    MScore::noConcurrentMidi = false;
+bool    MScore::skipXmlValidation = false;
 bool    MScore::pdfPrinting = false;
 bool    MScore::svgPrinting = false;
 
@@ -282,6 +287,9 @@ void MScore::init()
       defaultColor        = Qt::black;
       dropColor           = QColor("#1778db");
       defaultPlayDuration = 300;      // ms
+      undoMemoryLimit     = 512 * 1024;     // kB
+      imageCacheLimit     = 64 * 1024;      // kB
+      unusedImageLimit    = 32 * 1024;      // kB
       warnPitchRange      = true;
       playRepeats         = true;
       panPlayback         = true;
@@ -404,6 +404,9 @@ class MScore : public QObject {
       static qreal nudgeStep10;
       static qreal nudgeStep50;
       static int defaultPlayDuration;
+      static int undoMemoryLimit;         // kB of undo history per score, 0: unlimited
+      static int imageCacheLimit;         // kB of decoded and scaled raster images
+      static int unusedImageLimit;        // kB of image data kept after the last image using it is gone
       static QString lastError;
 
 // #ifndef NDEBUG
@@ -429,6 +432,8 @@ class MScore : public QObject {
 
       static bool noExcerpts;
       static bool noImages;
+      static bool noConcurrentMidi;        // render the staves one after the other
+      static bool skipXmlValidation;       // import MusicXML without schema validation
 
       static bool pdfPrinting;
       static bool svgPrinting;
@@ -58,6 +58,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Note)
+
 //---------------------------------------------------------
 //   noteHeads
 //    notehead groups
@@ -539,7 +541,8 @@ NoteHead::Group NoteHead::headGroup() const
 //---------------------------------------------------------
 
 Note::Note(Score* s)
-   : Element(s)
+   : Element(s), _ghost(false), _hidden(false), _dotsHidden(false), _fretConflict(false), dragMode(false),
+     _mirror(false), _small(false), _play(true), _mark(false), _fixed(false)
       {
       setFlags(ElementFlag::MOVABLE | ElementFlag::SELECTABLE);
       _playEvents.append(NoteEvent());    // add default play event
@@ -556,7 +559,7 @@ Note::~Note()
       }
 
 Note::Note(const Note& n, bool link)
-   : Element(n)
+   : Element(n), _mark(false)
       {
       if (link)
             score()->undo(new Link(const_cast<Note*>(&n), this));
@@ -244,20 +244,21 @@ class Note : public Element {
       void qmlSetAccidentalType(int t) { setAccidentalType(static_cast<AccidentalType>(t)); }
 
    private:
-      bool _ghost         { false };      ///< ghost note (guitar: death note)
-      bool _hidden        { false };      ///< markes this note as the hidden one if there are
-                                          ///< overlapping notes; hidden notes are not played
-                                          ///< and heads + accidentals are not shown
-      bool _dotsHidden    { false };      ///< dots of hidden notes are hidden too
-                                          ///< except if only one note is dotted
-      bool _fretConflict  { false };      ///< used by TAB staves to mark a fretting conflict:
-                                          ///< two or mor enotes on the same string
-      bool dragMode       { false };
-      bool _mirror        { false };      ///< True if note is mirrored at stem.
-      bool _small         { false };
-      bool _play          { true  };      // note is not played if false
-      mutable bool _mark  { false };      // for use in sequencer
-      bool _fixed         { false };      // for slash notation
+      // flags are packed as bit fields; they are initialized in the constructors
+      bool _ghost         : 1;      ///< ghost note (guitar: death note)
+      bool _hidden        : 1;      ///< markes this note as the hidden one if there are
+                                    ///< overlapping notes; hidden notes are not played
+                                    ///< and heads + accidentals are not shown
+      bool _dotsHidden    : 1;      ///< dots of hidden notes are hidden too
+                                    ///< except if only one note is dotted
+      bool _fretConflict  : 1;      ///< used by TAB staves to mark a fretting conflict:
+                                    ///< two or mor enotes on the same string
+      bool dragMode       : 1;
+      bool _mirror        : 1;      ///< True if note is mirrored at stem.
+      bool _small         : 1;
+      bool _play          : 1;      // note is not played if false
+      mutable bool _mark  : 1;      // for use in sequencer
+      bool _fixed         : 1;      // for slash notation
 
       MScore::DirectionH _userMirror { MScore::DirectionH::AUTO };      ///< user override of mirror
       Direction _userDotPosition     { Direction::AUTO };               ///< user override of dot position
@@ -526,6 +527,8 @@ class Note : public Element {
       void setOnTimeType(int v)  { _onTimeType = v; }
       int offTimeType() const    { return _offTimeType; }
       int onTimeType() const     { return _onTimeType; }
+
+      ELEMENT_POOL
       };
 
 }     // namespace Ms
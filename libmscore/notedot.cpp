@@ -19,6 +19,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(NoteDot)
+
 //---------------------------------------------------------
 //   NoteDot
 //---------------------------------------------------------
@@ -37,6 +37,8 @@ class NoteDot : public Element {
       virtual void layout() override;
 
       Note* note() const { return (Note*)parent(); }
+
+      ELEMENT_POOL
       };
 
 
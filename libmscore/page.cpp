@@ -32,6 +32,8 @@
 
 namespace Ms {
 
+int Page::revisionCounter = 0;
+
 //---------------------------------------------------------
 //   Page
 //---------------------------------------------------------
@@ -42,6 +44,7 @@ Page::Page(Score* s)
       {
       setFlags(0);
       bspTreeValid = false;
+      _revision    = ++revisionCounter;
       }
 
 Page::~Page()
@@ -42,6 +42,8 @@ class Page : public Element {
       void doRebuildBspTree();
 #endif
       bool bspTreeValid;
+      int _revision;                // changes each time the page is laid out
+      static int revisionCounter;
 
       QString replaceTextMacros(const QString&) const;
       void drawHeaderFooter(QPainter*, int area, const QString&) const;
@@ -74,7 +76,8 @@ class Page : public Element {
 
       QList<Element*> items(const QRectF& r);
       QList<Element*> items(const QPointF& p);
-      void rebuildBspTree()   { bspTreeValid = false; }
+      void rebuildBspTree()   { bspTreeValid = false; _revision = ++revisionCounter; }
+      int revision() const    { return _revision; }
       QPointF pagePos() const { return QPointF(); }     ///< position in page coordinates
       QList<Element*> elements();               ///< list of visible elements
       QRectF tbbox();                           // tight bounding box, excluding white space
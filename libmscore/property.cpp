@@ -316,11 +316,15 @@ static constexpr PropertyMetaData propertyList[] = {
 
 P_ID propertyId(const QString& s)
       {
-      for (const PropertyMetaData& pd : propertyList) {
-            if (pd.qml == s)
-                  return pd.id;
-            }
-      return P_ID::END;
+      static const QHash<QString, P_ID> ids = [] {
+            QHash<QString, P_ID> h;
+            for (const PropertyMetaData& pd : propertyList) {
+                  if (!h.contains(pd.qml))      // first entry wins, as in a linear search
+                        h.insert(pd.qml, pd.id);
+                  }
+            return h;
+            }();
+      return ids.value(s, P_ID::END);
       }
 
 //---------------------------------------------------------
@@ -16,6 +16,7 @@
 */
 
 #include <set>
+#include <QtConcurrent/QtConcurrentMap>
 
 #include "score.h"
 #include "volta.h"
@@ -373,13 +374,15 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                   if (cr == 0 || cr->type() != ElementType::CHORD)
                         continue;
 
+                  // staves are rendered concurrently: use const access to
+                  // shared containers, which never detaches them
                   Chord* chord = static_cast<Chord*>(cr);
                   Staff* staff = chord->staff();
                   int velocity = staff->velocities().velo(seg->tick());
-                  Instrument* instr = chord->part()->instrument(tick);
+                  const Instrument* instr = chord->part()->instrument(tick);
                   int channel = instr->channel(chord->upNote()->subchannel())->channel;
 
-                  for (Articulation* a : chord->articulations())
+                  for (Articulation* a : static_cast<const Chord*>(chord)->articulations())
                         instr->updateVelocity(&velocity,channel, a->articulationName());
 
                   if ( !graceNotesMerged(chord))
@@ -410,7 +413,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                   const StaffText* st = static_cast<const StaffText*>(e);
                   int tick = s->tick() + tickOffset;
 
-                  Instrument* instr = e->part()->instrument(tick);
+                  const Instrument* instr = e->part()->instrument(tick);
                   for (const ChannelActions& ca : *st->channelActions()) {
                         int channel = instr->channel().at(ca.channel)->channel;
                         for (const QString& ma : ca.midiActionNames) {
@@ -575,50 +578,59 @@ void Score::updateVelo()
             velo.clear();
             velo.setVelo(0, 80);
             }
-      for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
+
+      // collect dynamics and hairpins of all staves in one pass
+      int n = nstaves();
+      std::vector<std::vector<std::pair<int, const Dynamic*>>> dynamics(n);
+      for (Segment* s = firstMeasure()->first(); s; s = s->next1()) {
+            for (const Element* e : s->annotations()) {
+                  if (e->type() != ElementType::DYNAMIC)
+                        continue;
+                  int staffIdx = e->staffIdx();
+                  if (staffIdx >= 0 && staffIdx < n)
+                        dynamics[staffIdx].push_back(std::make_pair(s->tick(), static_cast<const Dynamic*>(e)));
+                  }
+            }
+      std::vector<std::vector<Hairpin*>> hairpins(n);
+      for (const auto& sp : _spanner.map()) {
+            Spanner* s = sp.second;
+            if (s->type() == ElementType::HAIRPIN && s->staffIdx() >= 0 && s->staffIdx() < n)
+                  hairpins[s->staffIdx()].push_back(static_cast<Hairpin*>(s));
+            }
+
+      // apply them staff by staff, so that of several settings
+      // for the same tick the same one wins as with a scan per staff
+      for (int staffIdx = 0; staffIdx < n; ++staffIdx) {
             Staff* st      = staff(staffIdx);
             VeloList& velo = st->velocities();
             Part* prt      = st->part();
             int partStaves = prt->nstaves();
             int partStaff  = Score::staffIdx(prt);
 
-            for (Segment* s = firstMeasure()->first(); s; s = s->next1()) {
-                  int tick = s->tick();
-                  for (const Element* e : s->annotations()) {
-                        if (e->staffIdx() != staffIdx)
-                              continue;
-                        if (e->type() != ElementType::DYNAMIC)
-                              continue;
-                        const Dynamic* d = static_cast<const Dynamic*>(e);
-                        int v            = d->velocity();
-                        if (v < 1)     //  illegal value
-                              continue;
-                        int dStaffIdx = d->staffIdx();
-                        switch(d->dynRange()) {
-                              case Dynamic::Range::STAFF:
-                                    if (dStaffIdx == staffIdx)
-                                          velo.setVelo(tick, v);
-                                    break;
-                              case Dynamic::Range::PART:
-                                    if (dStaffIdx >= partStaff && dStaffIdx < partStaff+partStaves) {
-                                          for (int i = partStaff; i < partStaff+partStaves; ++i)
-                                                staff(i)->velocities().setVelo(tick, v);
-                                          }
-                                    break;
-                              case Dynamic::Range::SYSTEM:
-                                    for (int i = 0; i < nstaves(); ++i)
+            for (const auto& td : dynamics[staffIdx]) {
+                  int tick         = td.first;
+                  const Dynamic* d = td.second;
+                  int v            = d->velocity();
+                  if (v < 1)     //  illegal value
+                        continue;
+                  switch(d->dynRange()) {
+                        case Dynamic::Range::STAFF:
+                              velo.setVelo(tick, v);
+                              break;
+                        case Dynamic::Range::PART:
+                              if (staffIdx >= partStaff && staffIdx < partStaff+partStaves) {
+                                    for (int i = partStaff; i < partStaff+partStaves; ++i)
                                           staff(i)->velocities().setVelo(tick, v);
-                                    break;
-                              }
+                                    }
+                              break;
+                        case Dynamic::Range::SYSTEM:
+                              for (int i = 0; i < n; ++i)
+                                    staff(i)->velocities().setVelo(tick, v);
+                              break;
                         }
                   }
-            for (const auto& sp : _spanner.map()) {
-                  Spanner* s = sp.second;
-                  if (s->type() != ElementType::HAIRPIN || sp.second->staffIdx() != staffIdx)
-                        continue;
-                  Hairpin* h = static_cast<Hairpin*>(s);
+            for (Hairpin* h : hairpins[staffIdx])
                   updateHairpin(h);
-                  }
             }
       }
 
@@ -1709,8 +1721,28 @@ void Score::renderMidi(EventMap* events)
       updateVelo();
 
       // create note & other events
-      for (Staff* part : _staves)
-            renderStaff(events, part);
+      // The staves are rendered concurrently, each into its own event map.
+      // Merging the maps in staff order keeps events at the same tick in
+      // the order of rendering the staves one after the other.
+      // Rendering only reads the score; the measure index is shared
+      // and must be up to date before the threads start.
+      tickIndex(false);
+      if (MScore::noConcurrentMidi) {
+            for (Staff* st : _staves)
+                  renderStaff(events, st);
+            }
+      else {
+            struct StaffEvents {
+                  Staff* staff;
+                  EventMap events;
+                  };
+            QVector<StaffEvents> staffEvents;
+            for (Staff* st : _staves)
+                  staffEvents.append({ st, EventMap() });
+            QtConcurrent::blockingMap(staffEvents, [this](StaffEvents& se) { renderStaff(&se.events, se.staff); });
+            for (const StaffEvents& se : staffEvents)
+                  events->insert(se.events.begin(), se.events.end());
+            }
 
       // create sustain pedal events
       renderSpanners(events, -1);
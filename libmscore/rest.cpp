@@ -32,6 +32,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Rest)
+
 //---------------------------------------------------------
 //    Rest
 //--------------------------------------------------------
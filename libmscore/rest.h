@@ -100,6 +100,8 @@ class Rest : public ChordRest {
       virtual QString accessibleInfo() const override;
       virtual QString screenReaderInfo() const override;
       Shape shape() const override;
+
+      ELEMENT_POOL
       };
 
 }     // namespace Ms
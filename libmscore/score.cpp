@@ -99,6 +99,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
       {
+      ++_revision;
       ++_size;
       if (_last) {
             _last->setNext(e);
@@ -119,6 +120,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
       {
+      ++_revision;
       ++_size;
       if (_first) {
             _first->setPrev(e);
@@ -149,6 +151,7 @@ void MeasureBaseList::add(MeasureBase* e)
             push_front(e);
             return;
             }
+      ++_revision;
       ++_size;
       e->setPrev(el->prev());
       el->prev()->setNext(e);
@@ -161,6 +164,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
       {
+      ++_revision;
       --_size;
       if (el->prev())
             el->prev()->setNext(el->next());
@@ -178,6 +182,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
       {
+      ++_revision;
       ++_size;
       for (MeasureBase* m = fm; m != lm; m = m->next())
             ++_size;
@@ -199,6 +204,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
       {
+      ++_revision;
       --_size;
       for (MeasureBase* m = fm; m != lm; m = m->next())
             --_size;
@@ -220,6 +226,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
       {
+      ++_revision;
       nb->setPrev(ob->prev());
       nb->setNext(ob->next());
       if (ob->prev())
@@ -4424,6 +4431,36 @@ void MasterScore::setLayout(int t)
       _cmdState.setTick(t);
       }
 
+//---------------------------------------------------------
+//   addChangedRange
+//    remember a laid out tick range for views which
+//    update lazily, like the timeline
+//---------------------------------------------------------
+
+void MasterScore::addChangedRange(int startTick, int endTick)
+      {
+      if (_changedStartTick == -1 || startTick < _changedStartTick)
+            _changedStartTick = startTick;
+      if (_changedEndTick == -1 || endTick > _changedEndTick)
+            _changedEndTick = endTick;
+      }
+
+//---------------------------------------------------------
+//   takeChangedRange
+//    return false if nothing changed since the last call
+//---------------------------------------------------------
+
+bool MasterScore::takeChangedRange(int* startTick, int* endTick)
+      {
+      if (_changedStartTick == -1)
+            return false;
+      *startTick = _changedStartTick;
+      *endTick   = _changedEndTick;
+      _changedStartTick = -1;
+      _changedEndTick   = -1;
+      return true;
+      }
+
 //---------------------------------------------------------
 //   isTopScore
 //---------------------------------------------------------
@@ -140,6 +140,7 @@ class MeasureBaseList {
       int _size;
       MeasureBase* _first;
       MeasureBase* _last;
+      int _revision { 0 };          // incremented on every change of the list
 
       void push_back(MeasureBase* e);
       void push_front(MeasureBase* e);
@@ -148,13 +149,14 @@ class MeasureBaseList {
       MeasureBaseList();
       MeasureBase* first() const { return _first; }
       MeasureBase* last()  const { return _last; }
-      void clear()               { _first = _last = 0; _size = 0; }
+      void clear()               { _first = _last = 0; _size = 0; ++_revision; }
       void add(MeasureBase*);
       void remove(MeasureBase*);
       void insert(MeasureBase*, MeasureBase*);
       void remove(MeasureBase*, MeasureBase*);
       void change(MeasureBase* o, MeasureBase* n);
       int size() const { return _size; }
+      int revision() const { return _revision; }
       };
 
 //---------------------------------------------------------
@@ -383,6 +385,11 @@ class Score : public QObject, ScoreElement {
       QList<MuseScoreView*> viewer;
       Excerpt* _excerpt  { 0 };
 
+      bool _layoutPending { false };      ///< layout deferred while no view shows this score
+      int _pendingStartTick { -1 };
+      int _pendingEndTick   { -1 };
+      LayoutFlags _pendingLayoutFlags;
+
       QString _mscoreVersion;
       int _mscoreRevision;
 
@@ -397,6 +404,20 @@ class Score : public QObject, ScoreElement {
       UpdateState _updateState;
 
       MeasureBaseList _measures;          // here are the notes
+
+      //
+      // measure index for tick2measure() and tick2measureMM(), rebuilt
+      // on demand after the measure list or a measure tick changed
+      //
+      struct TickIndex {
+            std::vector<Measure*> measures;     // sorted by tick
+            int revision { -1 };                // _measures.revision() at build time, -1: invalid
+            bool mmRests { false };             // built with multi measure rests
+            bool sorted  { false };             // false if ticks are not monotonic (during edits)
+            };
+      mutable TickIndex _tickIndex;
+      mutable TickIndex _tickIndexMM;
+      const TickIndex& tickIndex(bool mmRests) const;
       QList<Part*> _parts;
       QList<Staff*> _staves;
 
@@ -483,6 +504,7 @@ class Score : public QObject, ScoreElement {
       bool layoutSystem1(qreal& minWidth, bool, bool);
       QList<System*> layoutSystemRow(qreal w, bool, bool);
       System* getNextSystem(LayoutContext&);
+      bool layoutLinearRange(int stick, int etick);
       bool doReLayout();
 
       void beamGraceNotes(Chord*, bool);
@@ -494,7 +516,6 @@ class Score : public QObject, ScoreElement {
 
       bool rewriteMeasures(Measure* fm, Measure* lm, const Fraction&, int staffIdx);
       bool rewriteMeasures(Measure* fm, const Fraction& ns, int staffIdx);
-      void updateVelo();
       void swingAdjustParams(Chord*, int&, int&, int, int);
       bool isSubdivided(ChordRest*, int);
       void addAudioTrack();
@@ -562,6 +583,7 @@ class Score : public QObject, ScoreElement {
       void setExcerpt(Excerpt* e)   { _excerpt = e;     }
 
       System* collectSystem(LayoutContext&);
+      void layoutSystemElements(System*, const std::vector<MeasureBase*>&);
       void getNextMeasure(LayoutContext&);      // get next measure for layout
 
       void cmdRemovePart(Part*);
@@ -765,6 +787,7 @@ class Score : public QObject, ScoreElement {
       int pos();
       Measure* tick2measure(int tick) const;
       Measure* tick2measureMM(int tick) const;
+      void invalidateTickIndex()    { _tickIndex.revision = -1; _tickIndexMM.revision = -1; }
       MeasureBase* tick2measureBase(int tick) const;
       Segment* tick2segment(int tick, bool first, SegmentType st, bool useMMrest = false) const;
       Segment* tick2segment(int tick) const;
@@ -868,6 +891,7 @@ class Score : public QObject, ScoreElement {
       void addLyrics(int tick, int staffIdx, const QString&);
 
       void updateSwing();
+      void updateVelo();
       void createPlayEvents();
 
       void cmdConcertPitchChanged(bool, bool /*useSharpsFlats*/);
@@ -968,6 +992,11 @@ class Score : public QObject, ScoreElement {
 
       void doLayout();
       void doLayoutRange(int, int);
+      void deferLayoutRange(int, int, LayoutFlags);
+      bool layoutPending() const          { return _layoutPending; }
+      int pendingStartTick() const        { return _pendingStartTick; }
+      int pendingEndTick() const          { return _pendingEndTick; }
+      void doPendingLayout();
       void layoutLinear(LayoutContext& lc);
 
       void layoutSystemsUndoRedo();
@@ -1168,6 +1197,8 @@ class MasterScore : public Score {
       Movements* _movements   { 0 };
 
       CmdState _cmdState;     // modified during cmd processing
+      int _changedStartTick   { -1 };       // tick range laid out since the last takeChangedRange()
+      int _changedEndTick     { -1 };
 
       Omr* _omr               { 0 };
       bool _showOmr           { false };
@@ -1226,6 +1257,8 @@ class MasterScore : public Score {
       void setExcerptsChanged(bool val)                               { _cmdState._excerptsChanged = val;     }
       bool excerptsChanged() const                                    { return _cmdState._excerptsChanged;    }
       bool instrumentsChanged() const                                 { return _cmdState._instrumentsChanged; }
+      void addChangedRange(int startTick, int endTick);
+      bool takeChangedRange(int* startTick, int* endTick);
 
       Revisions* revisions()                                          { return _revisions;                    }
 
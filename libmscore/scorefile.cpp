@@ -79,6 +79,8 @@ static void writeMeasure(XmlWriter& xml, MeasureBase* m, int staffIdx, bool writ
 
 void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
       {
+      doPendingLayout();
+
       // if we have multi measure rests and some parts are hidden,
       // then some layout information is missing:
       // relayout with all parts set visible
@@ -547,8 +549,10 @@ bool Score::saveCompressedFile(QIODevice* f, QFileInfo& info, bool onlySelection
       xml.etag();
       xml.etag();
       cbuf.seek(0);
+      // independent entries are compressed concurrently
+      QList<QPair<QString, QByteArray>> entries;
       //uz.addDirectory("META-INF");
-      uz.addFile("META-INF/container.xml", cbuf.data());
+      entries.append(qMakePair(QString("META-INF/container.xml"), cbuf.data()));
 
       // save images
       //uz.addDirectory("Pictures");
@@ -556,7 +560,7 @@ bool Score::saveCompressedFile(QIODevice* f, QFileInfo& info, bool onlySelection
             if (!ip->isUsed(this))
                   continue;
             QString path = QString("Pictures/") + ip->hashName();
-            uz.addFile(path, ip->buffer());
+            entries.append(qMakePair(path, ip->buffer()));
             }
 
       // create thumbnail
@@ -569,8 +573,9 @@ bool Score::saveCompressedFile(QIODevice* f, QFileInfo& info, bool onlySelection
                   qDebug("open buffer failed");
             if (!pm.save(&b, "PNG"))
                   qDebug("save failed");
-            uz.addFile("Thumbnails/thumbnail.png", ba);
+            entries.append(qMakePair(QString("Thumbnails/thumbnail.png"), ba));
             }
+      uz.addFiles(entries);
 
 #ifdef OMR
       //
@@ -598,11 +603,14 @@ bool Score::saveCompressedFile(QIODevice* f, QFileInfo& info, bool onlySelection
       if (_audio)
             uz.addFile("audio.ogg", _audio->data());
 
-      QBuffer dbuf;
-      dbuf.open(QIODevice::ReadWrite);
-      saveFile(&dbuf, true, onlySelection);
-      dbuf.seek(0);
-      uz.addFile(fn, dbuf.data());
+      // the score is deflated while it is written
+      QIODevice* dbuf = uz.openFile(fn);
+      if (!dbuf) {
+            MScore::lastError = QObject::tr("Cannot write %1").arg(fn);
+            return false;
+            }
+      saveFile(dbuf, true, onlySelection);
+      delete dbuf;
       uz.close();
       return true;
       }
@@ -778,20 +786,24 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
                   }
             }
 
-      QByteArray dbuf = uz.fileData(rootfile);
-      if (dbuf.isEmpty()) {
+      // the score is inflated while it is parsed
+      QScopedPointer<QIODevice> dbuf(uz.openFile(rootfile));
+      if (!dbuf) {
             QList<MQZipReader::FileInfo> fil = uz.fileInfoList();
             foreach(const MQZipReader::FileInfo& fi, fil) {
                   if (fi.filePath.endsWith(".mscx")) {
-                        dbuf = uz.fileData(fi.filePath);
+                        dbuf.reset(uz.openFile(fi.filePath));
                         break;
                         }
                   }
             }
-      XmlReader e(this, dbuf);
+      if (!dbuf)
+            return FileError::FILE_NO_ROOTFILE;
+      XmlReader e(this, dbuf.data());
       e.setDocName(masterScore()->fileInfo()->completeBaseName());
 
       FileError retval = read1(e, ignoreVersionError);
+      dbuf.reset();
 
 #ifdef OMR
       //
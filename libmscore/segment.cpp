@@ -39,6 +39,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Segment)
+
 //---------------------------------------------------------
 //   subTypeName
 //---------------------------------------------------------
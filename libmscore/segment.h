@@ -267,6 +267,8 @@ class Segment : public Element {
       bool isEndBarLineType() const         { return _segmentType == SegmentType::EndBarLine; }
       bool isKeySigAnnounceType() const     { return _segmentType == SegmentType::KeySigAnnounce; }
       bool isTimeSigAnnounceType() const    { return _segmentType == SegmentType::TimeSigAnnounce; }
+
+      ELEMENT_POOL
       };
 
 //---------------------------------------------------------
@@ -411,10 +411,12 @@ void Selection::appendFiltered(Element* e)
 //   appendChord
 //---------------------------------------------------------
 
-void Selection::appendChord(Chord* chord)
+void Selection::appendChord(Chord* chord, QSet<Beam*>& beams)
       {
-      if (chord->beam() && !_el.contains(chord->beam()))
+      if (chord->beam() && !beams.contains(chord->beam())) {
+            beams.insert(chord->beam());
             _el.append(chord->beam());
+            }
       if (chord->stem())
             _el.append(chord->stem());
       if (chord->hook())
@@ -464,6 +466,7 @@ void Selection::updateSelectedElements()
             }
       int startTrack = _staffStart * VOICES;
       int endTrack   = _staffEnd * VOICES;
+      QSet<Beam*> beams;            // beams already appended, shared by several chords
 
       for (int st = startTrack; st < endTrack; ++st) {
             if (!canSelectVoice(st))
@@ -493,8 +496,8 @@ void Selection::updateSelectedElements()
                   if (e->isChord()) {
                         Chord* chord = toChord(e);
                         for (Chord* graceNote : chord->graceNotes())
-                              if (canSelect(graceNote)) appendChord(graceNote);
-                        appendChord(chord);
+                              if (canSelect(graceNote)) appendChord(graceNote, beams);
+                        appendChord(chord, beams);
                         }
                   else {
                         appendFiltered(e);
@@ -504,8 +507,9 @@ void Selection::updateSelectedElements()
       int stick = startSegment()->tick();
       int etick = tickEnd();
 
-      for (auto i = _score->spanner().begin(); i != _score->spanner().end(); ++i) {
-            Spanner* sp = (*i).second;
+      // only spanners overlapping the range can be selected
+      for (auto i : _score->spannerMap().findOverlapping(stick, etick)) {
+            Spanner* sp = i.value;
             // ignore spanners belonging to other tracks
             if (sp->track() < startTrack || sp->track() >= endTrack)
                   continue;
@@ -1136,17 +1140,16 @@ bool Selection::measureRange(Measure** m1, Measure** m2) const
 const QList<Element*> Selection::uniqueElements() const
       {
       QList<Element*> l;
+      QSet<Element*> seen;
+      QSet<const LinkedElements*> seenLinks;    // linked elements share one LinkedElements
 
       for (Element* e : elements()) {
-            bool alreadyThere = false;
-            for (Element* ee : l) {
-                  if ((ee->links() && ee->links()->contains(e)) || e == ee) {
-                        alreadyThere = true;
-                        break;
-                        }
-                  }
-            if (!alreadyThere)
-                  l.append(e);
+            if (seen.contains(e) || (e->links() && seenLinks.contains(e->links())))
+                  continue;
+            seen.insert(e);
+            if (e->links())
+                  seenLinks.insert(e->links());
+            l.append(e);
             }
       return l;
       }
@@ -1161,18 +1164,17 @@ const QList<Element*> Selection::uniqueElements() const
 QList<Note*> Selection::uniqueNotes(int track) const
       {
       QList<Note*> l;
+      QSet<Note*> seen;
+      QSet<const LinkedElements*> seenLinks;
 
       for (Note* nn : noteList(track)) {
             for (Note* note : nn->tiedNotes()) {
-                  bool alreadyThere = false;
-                  for (Note* n : l) {
-                        if ((n->links() && n->links()->contains(note)) || n == note) {
-                              alreadyThere = true;
-                              break;
-                              }
-                        }
-                  if (!alreadyThere)
-                        l.append(note);
+                  if (seen.contains(note) || (note->links() && seenLinks.contains(note->links())))
+                        continue;
+                  seen.insert(note);
+                  if (note->links())
+                        seenLinks.insert(note->links());
+                  l.append(note);
                   }
             }
       return l;
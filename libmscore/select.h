@@ -28,6 +28,7 @@ class Segment;
 class Note;
 class Measure;
 class Chord;
+class Beam;
 
 //---------------------------------------------------------
 //   ElementPattern
@@ -137,7 +138,7 @@ class Selection {
       bool canSelect(Element* e) const { return selectionFilter().canSelect(e); }
       bool canSelectVoice(int track) const { return selectionFilter().canSelectVoice(track); }
       void appendFiltered(Element* e);
-      void appendChord(Chord* chord);
+      void appendChord(Chord* chord, QSet<Beam*>& beams);
 
    public:
       Selection()                      { _score = 0; _state = SelState::NONE; }
@@ -855,7 +855,7 @@ void Spanner::setTick(int v)
       {
       _tick = v;
       if (score())
-            score()->spannerMap().setDirty();
+            score()->spannerMap().updateSpanner(this);
       }
 
 //---------------------------------------------------------
@@ -875,7 +875,7 @@ void Spanner::setTicks(int v)
       {
       _ticks = v;
       if (score())
-            score()->spannerMap().setDirty();
+            score()->spannerMap().updateSpanner(this);
       }
 
 //---------------------------------------------------------
@@ -16,53 +16,198 @@
 namespace Ms {
 
 //---------------------------------------------------------
-//   SpannerMap
+//   SpannerMapNode
 //---------------------------------------------------------
 
-SpannerMap::SpannerMap()
-      : std::multimap<int, Spanner*>()
+struct SpannerMapNode {
+      int start;              // spanner tick
+      int stop;               // spanner tick2
+      int maxStop;            // maximum stop in this subtree
+      unsigned seq;           // tie break for equal start ticks
+      unsigned prio;          // treap heap priority
+      int mapKey;             // key of the spanner in the multimap
+      Spanner* spanner;
+      SpannerMapNode* left  { 0 };
+      SpannerMapNode* right { 0 };
+      };
+
+//---------------------------------------------------------
+//   treap helper
+//---------------------------------------------------------
+
+static unsigned mixBits(unsigned x)
+      {
+      x ^= x >> 16;
+      x *= 0x7feb352dU;
+      x ^= x >> 15;
+      x *= 0x846ca68bU;
+      x ^= x >> 16;
+      return x;
+      }
+
+static inline bool lessThan(const SpannerMapNode* a, const SpannerMapNode* b)
+      {
+      return a->start < b->start || (a->start == b->start && a->seq < b->seq);
+      }
+
+static inline void updateMaxStop(SpannerMapNode* n)
+      {
+      n->maxStop = n->stop;
+      if (n->left && n->left->maxStop > n->maxStop)
+            n->maxStop = n->left->maxStop;
+      if (n->right && n->right->maxStop > n->maxStop)
+            n->maxStop = n->right->maxStop;
+      }
+
+static SpannerMapNode* mergeNodes(SpannerMapNode* l, SpannerMapNode* r)
+      {
+      if (!l)
+            return r;
+      if (!r)
+            return l;
+      if (l->prio > r->prio) {
+            l->right = mergeNodes(l->right, r);
+            updateMaxStop(l);
+            return l;
+            }
+      r->left = mergeNodes(l, r->left);
+      updateMaxStop(r);
+      return r;
+      }
+
+static SpannerMapNode* insertNode(SpannerMapNode* t, SpannerMapNode* n)
+      {
+      if (!t)
+            return n;
+      if (n->prio > t->prio) {
+            // split t at n
+            SpannerMapNode** l = &n->left;
+            SpannerMapNode** r = &n->right;
+            std::vector<SpannerMapNode*> path;
+            while (t) {
+                  path.push_back(t);
+                  if (lessThan(t, n)) {
+                        *l = t;
+                        l  = &t->right;
+                        t  = t->right;
+                        }
+                  else {
+                        *r = t;
+                        r  = &t->left;
+                        t  = t->left;
+                        }
+                  }
+            *l = 0;
+            *r = 0;
+            for (auto i = path.rbegin(); i != path.rend(); ++i)
+                  updateMaxStop(*i);
+            updateMaxStop(n);
+            return n;
+            }
+      if (lessThan(n, t))
+            t->left = insertNode(t->left, n);
+      else
+            t->right = insertNode(t->right, n);
+      updateMaxStop(t);
+      return t;
+      }
+
+static SpannerMapNode* eraseNode(SpannerMapNode* t, SpannerMapNode* n)
+      {
+      if (!t)
+            return 0;
+      if (t == n) {
+            SpannerMapNode* m = mergeNodes(n->left, n->right);
+            n->left  = 0;
+            n->right = 0;
+            return m;
+            }
+      if (lessThan(n, t))
+            t->left = eraseNode(t->left, n);
+      else
+            t->right = eraseNode(t->right, n);
+      updateMaxStop(t);
+      return t;
+      }
+
+static void deleteNodes(SpannerMapNode* t)
+      {
+      if (t) {
+            deleteNodes(t->left);
+            deleteNodes(t->right);
+            delete t;
+            }
+      }
+
+static void findOverlappingNodes(const SpannerMapNode* t, int start, int stop, std::vector< ::Interval<Spanner*>>& result)
+      {
+      while (t && t->maxStop >= start) {
+            findOverlappingNodes(t->left, start, stop, result);
+            if (t->start > stop)          // all following spanners start later
+                  return;
+            if (t->stop >= start)
+                  result.push_back(::Interval<Spanner*>(t->start, t->stop, t->spanner));
+            t = t->right;
+            }
+      }
+
+static void findContainedNodes(const SpannerMapNode* t, int start, int stop, std::vector< ::Interval<Spanner*>>& result)
       {
-      dirty = true;
+      while (t) {
+            if (t->start >= start)
+                  findContainedNodes(t->left, start, stop, result);
+            if (t->start > stop)
+                  return;
+            if (t->start >= start && t->stop <= stop)
+                  result.push_back(::Interval<Spanner*>(t->start, t->stop, t->spanner));
+            t = t->right;
+            }
       }
 
 //---------------------------------------------------------
-//   update
-//   updates the internal lookup tree, not the map itself
+//   SpannerMap
 //---------------------------------------------------------
 
-void SpannerMap::update() const
+SpannerMap::SpannerMap()
+      : std::multimap<int, Spanner*>()
+      {
+      }
+
+SpannerMap::~SpannerMap()
       {
-      std::vector< ::Interval<Spanner*> > intervals;
-      for (auto i : *this)
-            intervals.push_back(Interval<Spanner*>(i.second->tick(), i.second->tick2(), i.second));
-      tree = IntervalTree<Spanner*>(intervals);
-      dirty = false;
+      deleteNodes(_root);
       }
 
 //---------------------------------------------------------
 //   findContained
 //---------------------------------------------------------
 
-const std::vector<Interval<Spanner*>>& SpannerMap::findContained(int start, int stop)
+void SpannerMap::findContained(int start, int stop, std::vector< ::Interval<Spanner*>>& result) const
+      {
+      findContainedNodes(_root, start, stop, result);
+      }
+
+std::vector< ::Interval<Spanner*>> SpannerMap::findContained(int start, int stop) const
       {
-      if (dirty)
-            update();
-      results.clear();
-      tree.findContained(start, stop, results);
-      return results;
+      std::vector< ::Interval<Spanner*>> result;
+      findContainedNodes(_root, start, stop, result);
+      return result;
       }
 
 //---------------------------------------------------------
 //   findOverlapping
 //---------------------------------------------------------
 
-const std::vector<Interval<Spanner*>>& SpannerMap::findOverlapping(int start, int stop)
+void SpannerMap::findOverlapping(int start, int stop, std::vector< ::Interval<Spanner*>>& result) const
       {
-      if (dirty)
-            update();
-      results.clear();
-      tree.findOverlapping(start, stop, results);
-      return results;
+      findOverlappingNodes(_root, start, stop, result);
+      }
+
+std::vector< ::Interval<Spanner*>> SpannerMap::findOverlapping(int start, int stop) const
+      {
+      std::vector< ::Interval<Spanner*>> result;
+      findOverlappingNodes(_root, start, stop, result);
+      return result;
       }
 
 //---------------------------------------------------------
@@ -73,14 +218,21 @@ void SpannerMap::addSpanner(Spanner* s)
       {
 #ifndef NDEBUG
       // check if spanner already in list
-      for (auto i = begin(); i != end(); ++i) {
-            if (i->second == s) {
-                  qFatal("SpannerMap::addSpanner: %s already in list %p", s->name(), s);
-                  }
-            }
+      if (_nodes.find(s) != _nodes.end())
+            qFatal("SpannerMap::addSpanner: %s already in list %p", s->name(), s);
 #endif
       insert(std::pair<int,Spanner*>(s->tick(), s));
-      dirty = true;
+
+      SpannerMapNode* n = new SpannerMapNode;
+      n->start   = s->tick();
+      n->stop    = s->tick2();
+      n->maxStop = n->stop;
+      n->seq     = _seq++;
+      n->prio    = mixBits(n->seq);
+      n->mapKey  = s->tick();
+      n->spanner = s;
+      _nodes[s]  = n;
+      _root      = insertNode(_root, n);
       }
 
 //---------------------------------------------------------
@@ -89,15 +241,52 @@ void SpannerMap::addSpanner(Spanner* s)
 
 bool SpannerMap::removeSpanner(Spanner* s)
       {
-      for (auto i = begin(); i != end(); ++i) {
-            if (i->second == s) {
-                  erase(i);
-                  dirty = true;
-                  return true;
+      auto ni = _nodes.find(s);
+      if (ni == _nodes.end()) {
+            qDebug("%s (%p) not found", s->name(), s);
+            return false;
+            }
+      SpannerMapNode* n = ni->second;
+      _nodes.erase(ni);
+      _root = eraseNode(_root, n);
+
+      auto r = equal_range(n->mapKey);
+      auto i = r.first;
+      for (; i != r.second; ++i) {
+            if (i->second == s)
+                  break;
+            }
+      if (i == r.second) {
+            for (i = begin(); i != end(); ++i) {
+                  if (i->second == s)
+                        break;
                   }
             }
-      qDebug("%s (%p) not found", s->name(), s);
-      return false;
+      if (i != end())
+            erase(i);
+      delete n;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   updateSpanner
+//    move the spanner in the lookup tree after its tick
+//    or length changed
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(Spanner* s)
+      {
+      auto ni = _nodes.find(s);
+      if (ni == _nodes.end())
+            return;
+      SpannerMapNode* n = ni->second;
+      if (n->start == s->tick() && n->stop == s->tick2())
+            return;
+      _root      = eraseNode(_root, n);
+      n->start   = s->tick();
+      n->stop    = s->tick2();
+      n->maxStop = n->stop;
+      _root      = insertNode(_root, n);
       }
 
 #ifndef NDEBUG
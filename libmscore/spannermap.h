@@ -15,24 +15,37 @@
 
 
 #include "thirdparty/intervaltree/IntervalTree.h"
+#include <unordered_map>
 
 namespace Ms {
 
 class Spanner;
+struct SpannerMapNode;
 
 //---------------------------------------------------------
 //   SpannerMap
+//    The interval lookup is an augmented treap ordered by
+//    start tick. Every node knows the maximum end tick of
+//    its subtree, so adding, removing and moving a spanner
+//    is O(log n). Queries do not modify the map and write
+//    into a caller provided vector.
 //---------------------------------------------------------
 
 class SpannerMap : std::multimap<int, Spanner*> {
-      mutable bool dirty;
-      mutable IntervalTree<Spanner*> tree;
-      std::vector< ::Interval<Spanner*> > results;
+      SpannerMapNode* _root { 0 };
+      std::unordered_map<const Spanner*, SpannerMapNode*> _nodes;
+      unsigned _seq { 0 };          // insertion counter, orders spanners with equal start tick
 
    public:
       SpannerMap();
-      const std::vector< ::Interval<Spanner*> >& findContained(int start, int stop);
-      const std::vector< ::Interval<Spanner*> >& findOverlapping(int start, int stop);
+      ~SpannerMap();
+      SpannerMap(const SpannerMap&) = delete;
+      SpannerMap& operator=(const SpannerMap&) = delete;
+
+      void findContained(int start, int stop, std::vector< ::Interval<Spanner*> >& result) const;
+      void findOverlapping(int start, int stop, std::vector< ::Interval<Spanner*> >& result) const;
+      std::vector< ::Interval<Spanner*> > findContained(int start, int stop) const;
+      std::vector< ::Interval<Spanner*> > findOverlapping(int start, int stop) const;
       const std::multimap<int, Spanner*>& map() const { return *this; }
       std::multimap<int,Spanner*>::const_reverse_iterator crbegin() const { return std::multimap<int, Spanner*>::crbegin(); }
       std::multimap<int,Spanner*>::const_reverse_iterator crend() const   { return std::multimap<int, Spanner*>::crend(); }
@@ -40,8 +53,7 @@ class SpannerMap : std::multimap<int, Spanner*> {
       std::multimap<int,Spanner*>::const_iterator cend() const  { return std::multimap<int, Spanner*>::cend(); }
       void addSpanner(Spanner* s);
       bool removeSpanner(Spanner* s);
-      void update() const;
-      void setDirty() const { dirty = true; }   // must be called if a spanner changes start/length
+      void updateSpanner(Spanner* s);     // must be called if a spanner changes start/length
 #ifndef NDEBUG
       void dump() const;
 #endif
@@ -26,6 +26,8 @@
 
 namespace Ms {
 
+ELEMENT_POOL_DEFINE(Stem)
+
 //---------------------------------------------------------
 //   Stem
 //    Notenhals
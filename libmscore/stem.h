@@ -68,6 +68,8 @@ class Stem : public Element {
       qreal len() const               { return _len; }
       qreal stemLen() const;
       QPointF p2() const              { return line.p2(); }
+
+      ELEMENT_POOL
       };
 
 
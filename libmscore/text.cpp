@@ -33,6 +33,120 @@ static const qreal superScriptOffset = -.9;      // of x-height
 
 //static const qreal tempotextOffset = 0.4; // of x-height // 80% of 50% = 2 spatiums
 
+TextMetricsCache textMetricsCache;
+
+//---------------------------------------------------------
+//   TextMetricsCache
+//---------------------------------------------------------
+
+TextMetricsCache::TextMetricsCache(int maxEntries)
+   : _metrics(maxEntries), _inFont(maxEntries)
+      {
+      }
+
+//---------------------------------------------------------
+//   key
+//    fonts are scaled with the resolution of the paint
+//    device
+//---------------------------------------------------------
+
+TextMetricsCache::Key TextMetricsCache::key(const QFont& font, const QString& text)
+      {
+      Key k;
+      k.font = font.key();
+      k.dpi  = MScore::paintDevice()->logicalDpiY();
+      k.text = text;
+      return k;
+      }
+
+//---------------------------------------------------------
+//   measure
+//    metrics of text, not cached
+//---------------------------------------------------------
+
+FragmentMetrics TextMetricsCache::measure(const QFont& font, const QString& text)
+      {
+      QFontMetricsF fm(font, MScore::paintDevice());
+      FragmentMetrics m;
+      m.width             = fm.width(text);
+      m.lineSpacing       = fm.lineSpacing();
+      m.xHeight           = fm.xHeight();
+      m.tightBoundingRect = fm.tightBoundingRect(text);
+      return m;
+      }
+
+//---------------------------------------------------------
+//   metrics
+//    text is replaced by the copy stored in the cache
+//---------------------------------------------------------
+
+FragmentMetrics TextMetricsCache::metrics(const QFont& font, QString& text)
+      {
+      Key k = key(font, text);
+      {
+      QMutexLocker locker(&_mutex);
+      if (CachedMetrics* c = _metrics.object(k)) {
+            text = c->text;
+            return c->metrics;
+            }
+      }
+      FragmentMetrics m = measure(font, text);
+
+      QMutexLocker locker(&_mutex);
+      _metrics.insert(k, new CachedMetrics { text, m });
+      return m;
+      }
+
+//---------------------------------------------------------
+//   inFont
+//---------------------------------------------------------
+
+bool TextMetricsCache::inFont(const QFont& font, const QString& text)
+      {
+      Key k = key(font, text);
+      {
+      QMutexLocker locker(&_mutex);
+      if (bool* ok = _inFont.object(k))
+            return *ok;
+      }
+      QFontMetricsF fm(font);
+      bool ok = true;
+      for (int i = 0; i < text.size(); ++i) {
+            QChar c = text[i];
+            if (c.isHighSurrogate()) {
+                  if (i+1 == text.size())
+                        qFatal("bad string");
+                  QChar c2 = text[i+1];
+                  ++i;
+                  uint v = QChar::surrogateToUcs4(c, c2);
+                  if (!fm.inFontUcs4(v)) {
+                        ok = false;
+                        break;
+                        }
+                  }
+            else {
+                  if (!fm.inFont(c)) {
+                        ok = false;
+                        break;
+                        }
+                  }
+            }
+      QMutexLocker locker(&_mutex);
+      _inFont.insert(k, new bool(ok));
+      return ok;
+      }
+
+//---------------------------------------------------------
+//   contains
+//    metrics of text are cached, does not count as use
+//---------------------------------------------------------
+
+bool TextMetricsCache::contains(const QFont& font, const QString& text) const
+      {
+      QMutexLocker locker(&_mutex);
+      return _metrics.contains(key(font, text));
+      }
+
 //---------------------------------------------------------
 //   TextEditData
 //---------------------------------------------------------
@@ -521,30 +635,7 @@ QFont TextFragment::font(const Text* t) const
 
             // check if all symbols are available
             font.setFamily(family);
-            QFontMetricsF fm(font);
-
-            bool fail = false;
-            for (int i = 0; i < text.size(); ++i) {
-                  QChar c = text[i];
-                  if (c.isHighSurrogate()) {
-                        if (i+1 == text.size())
-                              qFatal("bad string");
-                        QChar c2 = text[i+1];
-                        ++i;
-                        uint v = QChar::surrogateToUcs4(c, c2);
-                        if (!fm.inFontUcs4(v)) {
-                              fail = true;
-                              break;
-                              }
-                        }
-                  else {
-                        if (!fm.inFont(c)) {
-                              fail = true;
-                              break;
-                              }
-                        }
-                  }
-            if (fail)
+            if (!textMetricsCache.inFont(font, text))
                   family = ScoreFont::fallbackTextFont();
             }
       else
@@ -618,9 +709,9 @@ void TextBlock::layout(Text* t)
       else {
             for (TextFragment& f : _fragments) {
                   f.pos.setX(x);
-                  QFontMetricsF fm(f.font(t), MScore::paintDevice());
+                  FragmentMetrics fm = textMetricsCache.metrics(f.font(t), f.text);
                   if (f.format.valign() != VerticalAlignment::AlignNormal) {
-                        qreal voffset = fm.xHeight() / subScriptSize;   // use original height
+                        qreal voffset = fm.xHeight / subScriptSize;   // use original height
                         if (f.format.valign() == VerticalAlignment::AlignSubScript)
                               voffset *= subScriptOffset;
                         else
@@ -629,11 +720,9 @@ void TextBlock::layout(Text* t)
                         }
                   else
                         f.pos.setY(0.0);
-                  qreal w  = fm.width(f.text);
-                  _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
-                  x += w;
-                  // _lineSpacing = (_lineSpacing == 0 || fm.lineSpacing() == 0) ? qMax(_lineSpacing, fm.lineSpacing()) : qMin(_lineSpacing, fm.lineSpacing());
-                  _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+                  _bbox   |= fm.tightBoundingRect.translated(f.pos);
+                  x += fm.width;
+                  _lineSpacing = qMax(_lineSpacing, fm.lineSpacing);
                   }
             }
       qreal rx;
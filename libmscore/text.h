@@ -116,6 +116,64 @@ class TextCursor {
 
 class Text;
 
+//---------------------------------------------------------
+//   FragmentMetrics
+//    font metrics of a text fragment as needed by
+//    TextBlock::layout()
+//---------------------------------------------------------
+
+struct FragmentMetrics {
+      qreal width;
+      qreal lineSpacing;
+      qreal xHeight;
+      QRectF tightBoundingRect;
+      };
+
+//---------------------------------------------------------
+//   TextMetricsCache
+//    process wide cache of fragment metrics, keyed by
+//    QFont::key(), paint device resolution and fragment
+//    text. Identical syllables and chord names share one
+//    entry and one string. When full the least recently
+//    used entries are dropped.
+//---------------------------------------------------------
+
+class TextMetricsCache {
+   public:
+      struct Key {
+            QString font;
+            int dpi;
+            QString text;
+            bool operator==(const Key& k) const { return dpi == k.dpi && font == k.font && text == k.text; }
+            };
+
+   private:
+      struct CachedMetrics {
+            QString text;
+            FragmentMetrics metrics;
+            };
+
+      mutable QMutex _mutex;
+      QCache<Key, CachedMetrics> _metrics;
+      QCache<Key, bool> _inFont;                // all chars of text available in font family?
+
+      static Key key(const QFont&, const QString& text);
+
+   public:
+      TextMetricsCache(int maxEntries = 100000);
+      static FragmentMetrics measure(const QFont&, const QString& text);
+      FragmentMetrics metrics(const QFont&, QString& text);
+      bool inFont(const QFont&, const QString& text);
+      bool contains(const QFont&, const QString& text) const;
+      };
+
+inline uint qHash(const TextMetricsCache::Key& k, uint seed = 0)
+      {
+      return qHash(k.font, seed) ^ qHash(k.text, seed) ^ uint(k.dpi);
+      }
+
+extern TextMetricsCache textMetricsCache;
+
 //---------------------------------------------------------
 //   TextFragment
 //    contains a styled text
@@ -76,6 +76,12 @@
 #include "glissando.h"
 #include "stafflines.h"
 #include "bracket.h"
+#include "stem.h"
+#include "hook.h"
+#include "notedot.h"
+#include "ledgerline.h"
+#include "lyrics.h"
+#include "timesig.h"
 
 //      Q_LOGGING_CATEGORY(undoRedo, "undoRedo")
 
@@ -136,6 +142,105 @@ void UndoCommand::cleanup(bool undo)
             c->cleanup(undo);
       }
 
+//---------------------------------------------------------
+//   UndoCommand::memoryUsage
+//    estimated number of bytes held by the command
+//    and its children; undo is true if the command is
+//    on the undo stack, as for cleanup(). Elements
+//    which are part of the score are not counted.
+//---------------------------------------------------------
+
+int UndoCommand::memoryUsage(bool undo) const
+      {
+      int n = sizeof(UndoCommand);
+      for (auto c : childList)
+            n += c->memoryUsage(undo);
+      return n;
+      }
+
+//---------------------------------------------------------
+//   elementSize
+//---------------------------------------------------------
+
+static int elementSize(const Element* e)
+      {
+      switch (e->type()) {
+            case ElementType::MEASURE:       return sizeof(Measure);
+            case ElementType::SEGMENT:       return sizeof(Segment);
+            case ElementType::CHORD:         return sizeof(Chord);
+            case ElementType::NOTE:          return sizeof(Note);
+            case ElementType::REST:          return sizeof(Rest);
+            case ElementType::STEM:          return sizeof(Stem);
+            case ElementType::HOOK:          return sizeof(Hook);
+            case ElementType::NOTEDOT:       return sizeof(NoteDot);
+            case ElementType::ACCIDENTAL:    return sizeof(Accidental);
+            case ElementType::LEDGER_LINE:   return sizeof(LedgerLine);
+            case ElementType::BEAM:          return sizeof(Beam);
+            case ElementType::TUPLET:        return sizeof(Tuplet);
+            case ElementType::ARTICULATION:  return sizeof(Articulation);
+            case ElementType::LYRICS:        return sizeof(Lyrics);
+            case ElementType::CLEF:          return sizeof(Clef);
+            case ElementType::KEYSIG:        return sizeof(KeySig);
+            case ElementType::TIMESIG:       return sizeof(TimeSig);
+            case ElementType::BAR_LINE:      return sizeof(BarLine);
+            case ElementType::STAFF_LINES:   return sizeof(StaffLines);
+            default:                         return sizeof(Element);
+            }
+      }
+
+static void addElementSize(void* data, Element* e)
+      {
+      *static_cast<int*>(data) += elementSize(e);
+      }
+
+//---------------------------------------------------------
+//   containerMemoryUsage
+//    size of the measures, segments and chords in the
+//    subtree of e, which are not reported by scanElements()
+//---------------------------------------------------------
+
+static int containerMemoryUsage(const Element* e)
+      {
+      int n = 0;
+      switch (e->type()) {
+            case ElementType::MEASURE:
+                  n += sizeof(Measure);
+                  for (const Segment* s = toMeasure(e)->first(); s; s = s->next())
+                        n += containerMemoryUsage(s);
+                  break;
+            case ElementType::SEGMENT:
+                  n += sizeof(Segment);
+                  for (const Element* el : toSegment(e)->elist()) {
+                        if (el)
+                              n += containerMemoryUsage(el);
+                        }
+                  break;
+            case ElementType::CHORD:
+                  n += sizeof(Chord);
+                  for (const Chord* c : toChord(e)->graceNotes())
+                        n += containerMemoryUsage(c);
+                  break;
+            default:
+                  break;
+            }
+      return n;
+      }
+
+//---------------------------------------------------------
+//   elementMemoryUsage
+//    size of an element kept alive by the undo stack,
+//    including all elements it owns
+//---------------------------------------------------------
+
+static int elementMemoryUsage(const Element* e)
+      {
+      if (!e)
+            return 0;
+      int n = containerMemoryUsage(e);
+      const_cast<Element*>(e)->scanElements(&n, addElementSize, true);
+      return n;
+      }
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -183,9 +288,10 @@ void UndoCommand::unwind()
 
 UndoStack::UndoStack()
       {
-      curCmd   = 0;
-      curIdx   = 0;
-      cleanIdx = 0;
+      curCmd       = 0;
+      curIdx       = 0;
+      cleanIdx     = 0;
+      _memoryUsage = 0;
       }
 
 //---------------------------------------------------------
@@ -229,15 +335,57 @@ void UndoStack::endMacro(bool rollback)
             // remove redo stack
             while (list.size() > curIdx) {
                   UndoCommand* cmd = list.takeLast();
+                  _memoryUsage -= sizes.takeLast();
                   cmd->cleanup(false);  // delete elements for which UndoCommand() holds ownership
                   delete cmd;
                   }
+            int n = curCmd->memoryUsage(true);
+            qCDebug(undoRedo, "undo entry %d: %d children, %d bytes", curIdx, curCmd->childCount(), n);
             list.append(curCmd);
+            sizes.append(n);
+            _memoryUsage += n;
             ++curIdx;
+            trim();
             }
       curCmd = 0;
       }
 
+//---------------------------------------------------------
+//   updateMemoryUsage
+//    recompute the size of entry idx after it was undone
+//    or redone, elements change ownership then
+//---------------------------------------------------------
+
+void UndoStack::updateMemoryUsage(int idx)
+      {
+      int n = list[idx]->memoryUsage(idx < curIdx);
+      _memoryUsage += n - sizes[idx];
+      sizes[idx] = n;
+      }
+
+//---------------------------------------------------------
+//   trim
+//    drop the oldest entries while the history is larger
+//    than MScore::undoMemoryLimit; the latest entry is
+//    always kept
+//---------------------------------------------------------
+
+void UndoStack::trim()
+      {
+      int limit = MScore::undoMemoryLimit;
+      if (limit <= 0)
+            return;
+      while (curIdx > 1 && _memoryUsage > qint64(limit) * 1024) {
+            UndoCommand* cmd = list.takeFirst();
+            _memoryUsage -= sizes.takeFirst();
+            cmd->cleanup(true);     // the command is done, delete what it removed
+            delete cmd;
+            --curIdx;
+            if (cleanIdx >= 0)
+                  --cleanIdx;       // becomes -1 if the clean state is dropped
+            }
+      }
+
 //---------------------------------------------------------
 //   push
 //---------------------------------------------------------
@@ -261,8 +409,21 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
             qCDebug(undoRedo, "<%s>", cmd->name());
             }
 #endif
+      UndoCommand* prev = curCmd->lastChild();
       curCmd->appendChild(cmd);
       cmd->redo(ed);
+
+      // coalesce subsequent changes of the same property: the previous
+      // command already holds the value to restore on undo, and when undone
+      // it saves the current value for redo
+      ChangeProperty* p1 = dynamic_cast<ChangeProperty*>(prev);
+      ChangeProperty* p2 = dynamic_cast<ChangeProperty*>(cmd);
+      if (p1 && p2 && curCmd->lastChild() == cmd) {
+            if (p1->getElement() == p2->getElement() && p1->getId() == p2->getId()) {
+                  curCmd->removeChild();
+                  delete cmd;
+                  }
+            }
       }
 
 //---------------------------------------------------------
@@ -312,6 +473,7 @@ void UndoStack::undo(EditData* ed)
             --curIdx;
             Q_ASSERT(curIdx >= 0);
             list[curIdx]->undo(ed);
+            updateMemoryUsage(curIdx);
             }
       }
 
@@ -322,8 +484,11 @@ void UndoStack::undo(EditData* ed)
 void UndoStack::redo(EditData* ed)
       {
       qCDebug(undoRedo) << "===";
-      if (canRedo())
+      if (canRedo()) {
             list[curIdx++]->redo(ed);
+            updateMemoryUsage(curIdx - 1);
+            trim();
+            }
       }
 
 //---------------------------------------------------------
@@ -477,6 +642,16 @@ void AddElement::cleanup(bool undo)
             }
       }
 
+//---------------------------------------------------------
+//   AddElement::memoryUsage
+//    the element is owned by the command once undone
+//---------------------------------------------------------
+
+int AddElement::memoryUsage(bool undo) const
+      {
+      return sizeof(AddElement) + (undo ? 0 : elementMemoryUsage(element));
+      }
+
 //---------------------------------------------------------
 //   undoRemoveTuplet
 //---------------------------------------------------------
@@ -609,6 +784,16 @@ void RemoveElement::cleanup(bool undo)
             }
       }
 
+//---------------------------------------------------------
+//   RemoveElement::memoryUsage
+//    the element is owned by the command while done
+//---------------------------------------------------------
+
+int RemoveElement::memoryUsage(bool undo) const
+      {
+      return sizeof(RemoveElement) + (undo ? elementMemoryUsage(element) : 0);
+      }
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -1433,6 +1618,41 @@ void ChangeMStaffProperties::flip(EditData*)
       slashStyle = s;
       }
 
+//---------------------------------------------------------
+//   measuresMemoryUsage
+//    size of the measures fm - lm, which are owned by the
+//    command while they are not part of the score
+//---------------------------------------------------------
+
+int InsertRemoveMeasures::measuresMemoryUsage() const
+      {
+      int n = 0;
+      for (MeasureBase* mb = fm; mb; mb = mb->next()) {
+            n += elementMemoryUsage(mb);
+            if (mb == lm)
+                  break;
+            }
+      return n;
+      }
+
+//---------------------------------------------------------
+//   RemoveMeasures::memoryUsage
+//---------------------------------------------------------
+
+int RemoveMeasures::memoryUsage(bool undo) const
+      {
+      return sizeof(RemoveMeasures) + (undo ? measuresMemoryUsage() : 0);
+      }
+
+//---------------------------------------------------------
+//   InsertMeasures::memoryUsage
+//---------------------------------------------------------
+
+int InsertMeasures::memoryUsage(bool undo) const
+      {
+      return sizeof(InsertMeasures) + (undo ? 0 : measuresMemoryUsage());
+      }
+
 //---------------------------------------------------------
 //   insertMeasures
 //---------------------------------------------------------
@@ -1840,6 +2060,18 @@ void ChangeProperty::flip(EditData*)
       flags = ps;
       }
 
+//---------------------------------------------------------
+//   ChangeProperty::memoryUsage
+//---------------------------------------------------------
+
+int ChangeProperty::memoryUsage(bool) const
+      {
+      int n = sizeof(ChangeProperty);
+      if (property.type() == QVariant::String)
+            n += property.toString().size() * int(sizeof(QChar));
+      return n;
+      }
+
 //---------------------------------------------------------
 //   ChangeMetaText::flip
 //---------------------------------------------------------
@@ -105,8 +105,10 @@ class UndoCommand {
       void appendChild(UndoCommand* cmd) { childList.append(cmd);       }
       UndoCommand* removeChild()         { return childList.takeLast(); }
       int childCount() const             { return childList.size();     }
+      UndoCommand* lastChild() const     { return childList.empty() ? 0 : childList.last(); }
       void unwind();
       virtual void cleanup(bool undo);
+      virtual int memoryUsage(bool undo) const;
 // #ifndef QT_NO_DEBUG
       virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -119,9 +121,14 @@ class UndoCommand {
 class UndoStack {
       UndoCommand* curCmd;
       QList<UndoCommand*> list;
+      QList<int> sizes;             // estimated memory used by each entry of list
+      qint64 _memoryUsage;          // sum of sizes
       int curIdx;
       int cleanIdx;
 
+      void updateMemoryUsage(int idx);
+      void trim();
+
    public:
       UndoStack();
       ~UndoStack();
@@ -138,6 +145,9 @@ class UndoStack {
       bool isClean() const          { return cleanIdx == curIdx;   }
       bool empty() const            { return !canUndo() && !canRedo();  }
       UndoCommand* current() const  { return curCmd;               }
+      int size() const              { return list.size();          }
+      qint64 memoryUsage() const    { return _memoryUsage;         }
+      int memoryUsage(int idx) const { return sizes[idx];          }
       void undo(EditData*);
       void redo(EditData*);
       };
@@ -501,6 +511,7 @@ class AddElement : public UndoCommand {
    public:
       AddElement(Element*);
       virtual void cleanup(bool);
+      virtual int memoryUsage(bool undo) const override;
       virtual const char* name() const override;
       };
 
@@ -516,6 +527,7 @@ class RemoveElement : public UndoCommand {
       virtual void undo(EditData*) override;
       virtual void redo(EditData*) override;
       virtual void cleanup(bool);
+      virtual int memoryUsage(bool undo) const override;
       virtual const char* name() const override;
       };
 
@@ -693,6 +705,7 @@ class InsertRemoveMeasures : public UndoCommand {
    protected:
       void removeMeasures();
       void insertMeasures();
+      int measuresMemoryUsage() const;
 
    public:
       InsertRemoveMeasures(MeasureBase* _fm, MeasureBase* _lm) : fm(_fm), lm(_lm) {}
@@ -710,6 +723,7 @@ class RemoveMeasures : public InsertRemoveMeasures {
       RemoveMeasures(MeasureBase* m1, MeasureBase* m2) : InsertRemoveMeasures(m1, m2) {}
       virtual void undo(EditData*) override { insertMeasures(); }
       virtual void redo(EditData*) override { removeMeasures(); }
+      virtual int memoryUsage(bool undo) const override;
       UNDO_NAME("RemoveMeasures")
       };
 
@@ -723,6 +737,7 @@ class InsertMeasures : public InsertRemoveMeasures {
       InsertMeasures(MeasureBase* m1, MeasureBase* m2) : InsertRemoveMeasures(m1, m2) {}
       virtual void redo(EditData*) override { insertMeasures(); }
       virtual void undo(EditData*) override { removeMeasures(); }
+      virtual int memoryUsage(bool undo) const override;
       UNDO_NAME("InsertMeasures")
       };
 
@@ -944,6 +959,8 @@ class ChangeProperty : public UndoCommand {
       ChangeProperty(ScoreElement* e, P_ID i, const QVariant& v, PropertyFlags ps = PropertyFlags::NOSTYLE)
          : element(e), id(i), property(v), flags(ps) {}
       P_ID getId() const  { return id; }
+      ScoreElement* getElement() const { return element; }
+      virtual int memoryUsage(bool undo) const override;
       UNDO_NAME("ChangeProperty")
       };
 
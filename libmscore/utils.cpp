@@ -41,17 +41,60 @@ QRectF handleRect(const QPointF& pos)
       }
 
 //---------------------------------------------------------
-//   tick2measure
+//   tickIndex
+//    return the measure index, rebuild it if the measure
+//    list, a measure tick or a multi measure rest changed
 //---------------------------------------------------------
 
-Measure* Score::tick2measure(int tick) const
+const Score::TickIndex& Score::tickIndex(bool mmRests) const
       {
-      if (tick == -1)
-            return lastMeasure();
+      TickIndex& ti  = mmRests ? _tickIndexMM : _tickIndex;
+      bool useMMRest = mmRests && styleB(StyleIdx::createMultiMeasureRests);
+      if (ti.revision == _measures.revision() && ti.mmRests == useMMRest)
+            return ti;
+      ti.measures.clear();
+      ti.sorted = true;
+      int tick  = -1;
+      for (Measure* m = mmRests ? firstMeasureMM() : firstMeasure(); m; m = mmRests ? m->nextMeasureMM() : m->nextMeasure()) {
+            if (m->tick() < tick)
+                  ti.sorted = false;
+            tick = m->tick();
+            ti.measures.push_back(m);
+            }
+      ti.revision = _measures.revision();
+      ti.mmRests  = useMMRest;
+      return ti;
+      }
 
-      Q_ASSERT(firstMeasure());
+//---------------------------------------------------------
+//   findMeasure
+//    binary search in a measure list sorted by tick
+//---------------------------------------------------------
+
+static Measure* findMeasure(const std::vector<Measure*>& ml, int tick, bool* found)
+      {
+      *found = true;
+      auto i = std::upper_bound(ml.begin(), ml.end(), tick, [](int t, const Measure* m) { return t < m->tick(); });
+      if (i != ml.end())
+            return i == ml.begin() ? 0 : *(i - 1);
+      // check last measure
+      Measure* lm = ml.empty() ? 0 : ml.back();
+      if (lm && (tick >= lm->tick()) && (tick <= lm->endTick()))
+            return lm;
+      *found = false;
+      return 0;
+      }
+
+//---------------------------------------------------------
+//   searchMeasure
+//    linear search starting at measure m
+//---------------------------------------------------------
+
+static Measure* searchMeasure(Measure* m, int tick, bool mmRests, bool* found)
+      {
+      *found = true;
       Measure* lm = 0;
-      for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
+      for (; m; m = mmRests ? m->nextMeasureMM() : m->nextMeasure()) {
             if (tick < m->tick())
                   return lm;
             lm = m;
@@ -59,10 +102,34 @@ Measure* Score::tick2measure(int tick) const
       // check last measure
       if (lm && (tick >= lm->tick()) && (tick <= lm->endTick()))
             return lm;
-      qDebug("tick2measure %d (max %d) not found", tick, lm ? lm->tick() : -1);
+      *found = false;
       return 0;
       }
 
+//---------------------------------------------------------
+//   tick2measure
+//---------------------------------------------------------
+
+Measure* Score::tick2measure(int tick) const
+      {
+      if (tick == -1)
+            return lastMeasure();
+
+      Q_ASSERT(firstMeasure());
+      const TickIndex& ti = tickIndex(false);
+      bool found;
+      Measure* m = ti.sorted ? findMeasure(ti.measures, tick, &found) : searchMeasure(firstMeasure(), tick, false, &found);
+#ifndef NDEBUG
+      bool f;
+      Q_ASSERT_X(searchMeasure(firstMeasure(), tick, false, &f) == m && f == found, "Score::tick2measure", "measure index out of date");
+#endif
+      if (!found) {
+            Measure* lm = lastMeasure();
+            qDebug("tick2measure %d (max %d) not found", tick, lm ? lm->tick() : -1);
+            }
+      return m;
+      }
+
 //---------------------------------------------------------
 //   tick2measureMM
 //---------------------------------------------------------
@@ -71,18 +138,19 @@ Measure* Score::tick2measureMM(int tick) const
       {
       if (tick == -1)
             return lastMeasureMM();
-      Measure* lm = 0;
 
-      for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-            if (tick < m->tick())
-                  return lm;
-            lm = m;
+      const TickIndex& ti = tickIndex(true);
+      bool found;
+      Measure* m = ti.sorted ? findMeasure(ti.measures, tick, &found) : searchMeasure(firstMeasureMM(), tick, true, &found);
+#ifndef NDEBUG
+      bool f;
+      Q_ASSERT_X(searchMeasure(firstMeasureMM(), tick, true, &f) == m && f == found, "Score::tick2measureMM", "measure index out of date");
+#endif
+      if (!found) {
+            Measure* lm = lastMeasureMM();
+            qDebug("tick2measureMM %d (max %d) not found", tick, lm ? lm->tick() : -1);
             }
-      // check last measure
-      if (lm && (tick >= lm->tick()) && (tick <= lm->endTick()))
-            return lm;
-      qDebug("tick2measureMM %d (max %d) not found", tick, lm ? lm->tick() : -1);
-      return 0;
+      return m;
       }
 
 //---------------------------------------------------------
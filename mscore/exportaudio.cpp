@@ -32,6 +32,68 @@
 
 namespace Ms {
 
+//---------------------------------------------------------
+//   initInstruments
+//---------------------------------------------------------
+
+static void initInstruments(Score* score, MasterSynthesizer* synti)
+      {
+      foreach(Part* part, score->parts()) {
+            const InstrumentList* il = part->instruments();
+            for(auto i = il->begin(); i!= il->end(); i++) {
+                  foreach(const Channel* a, i->second->channel()) {
+                        a->updateInitList();
+                        foreach(MidiCoreEvent e, a->init) {
+                              if (e.type() == ME_INVALID)
+                                    continue;
+                              e.setChannel(a->channel);
+                              int syntiIdx = synti->index(score->masterScore()->midiMapping(a->channel)->articulation->synti);
+                              synti->play(e, syntiIdx);
+                              }
+                        }
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   renderPeriod
+//    play the events up to playTime + frames through synti
+//    and write its output to buffer, playTime and playPos
+//    are advanced to the end of the period
+//---------------------------------------------------------
+
+static void renderPeriod(Score* score, MasterSynthesizer* synti, const EventMap& events,
+   EventMap::const_iterator& playPos, int& playTime, float* buffer, unsigned frames)
+      {
+      memset(buffer, 0, sizeof(float) * frames * 2);
+      int endTime = playTime + frames;
+      float* p = buffer;
+      for (; playPos != events.cend(); ++playPos) {
+            int f = score->utick2utime(playPos->first) * MScore::sampleRate;
+            if (f >= endTime)
+                  break;
+            int n = f - playTime;
+            if (n) {
+                  synti->process(n, p);
+                  p += 2 * n;
+                  }
+
+            playTime  += n;
+            frames    -= n;
+            const NPlayEvent& e = playPos->second;
+            if (e.isChannelEvent()) {
+                  int channelIdx = e.channel();
+                  Channel* c = score->masterScore()->midiMapping(channelIdx)->articulation;
+                  if (!c->mute) {
+                        synti->play(e, synti->index(c->synti));
+                        }
+                  }
+            }
+      if (frames)
+            synti->process(frames, p);
+      playTime = endTime;
+      }
+
 ///
 /// \brief Function to synthesize audio and output it into a generic QIODevice
 /// \param The score to output
@@ -89,63 +151,18 @@ bool MuseScore::saveAudio(Score* score, QIODevice *device, std::function<bool(fl
           playPos = events.cbegin();
           synti->allSoundsOff(-1);
 
-          //
-          // init instruments
-          //
-          foreach(Part* part, score->parts()) {
-                const InstrumentList* il = part->instruments();
-                for(auto i = il->begin(); i!= il->end(); i++) {
-                      foreach(const Channel* a, i->second->channel()) {
-                            a->updateInitList();
-                            foreach(MidiCoreEvent e, a->init) {
-                                  if (e.type() == ME_INVALID)
-                                        continue;
-                                  e.setChannel(a->channel);
-                                  int syntiIdx = synti->index(score->masterScore()->midiMapping(a->channel)->articulation->synti);
-                                  synti->play(e, syntiIdx);
-                                  }
-                            }
-                      }
-                }
+          initInstruments(score, synti);
 
           static const unsigned FRAMES = 512;
           float buffer[FRAMES * 2];
           int playTime = 0;
 
           for (;;) {
-                unsigned frames = FRAMES;
                 //
                 // collect events for one segment
                 //
                 float max = 0.0;
-                memset(buffer, 0, sizeof(float) * FRAMES * 2);
-                int endTime = playTime + frames;
-                float* p = buffer;
-                for (; playPos != events.cend(); ++playPos) {
-                      int f = score->utick2utime(playPos->first) * MScore::sampleRate;
-                      if (f >= endTime)
-                            break;
-                      int n = f - playTime;
-                      if (n) {
-                            synti->process(n, p);
-                            p += 2 * n;
-                            }
-
-                      playTime  += n;
-                      frames    -= n;
-                      const NPlayEvent& e = playPos->second;
-                      if (e.isChannelEvent()) {
-                            int channelIdx = e.channel();
-                            Channel* c = score->masterScore()->midiMapping(channelIdx)->articulation;
-                            if (!c->mute) {
-                                  synti->play(e, synti->index(c->synti));
-                                  }
-                            }
-                      }
-                if (frames) {
-                      synti->process(frames, p);
-                      playTime += frames;
-                      }
+                renderPeriod(score, synti, events, playPos, playTime, buffer, FRAMES);
                 if (pass == 1) {
                       for (unsigned i = 0; i < FRAMES * 2; ++i) {
                             max = qMax(max, qAbs(buffer[i]));
@@ -159,7 +176,6 @@ bool MuseScore::saveAudio(Score* score, QIODevice *device, std::function<bool(fl
                             peak = qMax(peak, qAbs(buffer[i]));
                             }
                       }
-                playTime = endTime;
                 if (updateProgress) {
                     // normalize to [0, 1] range
                     if (!updateProgress((pass * et + playTime) / 2.0 / et)) {
@@ -193,6 +209,74 @@ bool MuseScore::saveAudio(Score* score, QIODevice *device, std::function<bool(fl
     return !cancelled;
 }
 
+//---------------------------------------------------------
+//   saveAudioProfile
+//    Render the score through the synthesizers as fast as
+//    possible, without an audio device, and write the audio
+//    profiler statistics and the realtime factor to name.
+//---------------------------------------------------------
+
+bool MuseScore::saveAudioProfile(Score* score, const QString& name)
+      {
+      EventMap events;
+      score->renderMidi(&events);
+      if (events.empty())
+            return false;
+
+      QFile file(name);
+      if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qDebug("cannot write <%s>", qPrintable(name));
+            return false;
+            }
+
+      MasterSynthesizer* synti = synthesizerFactory();
+      synti->init();
+      int sampleRate = preferences.exportAudioSampleRate;
+      synti->setSampleRate(sampleRate);
+      if (!synti->setState(score->synthesizerState()))
+            synti->init();
+
+      int oldSampleRate  = MScore::sampleRate;
+      MScore::sampleRate = sampleRate;
+
+      AudioProfiler* prof = synti->profiler();
+      prof->setEnabled(true);
+      prof->reset();
+
+      initInstruments(score, synti);
+
+      static const unsigned FRAMES = 512;
+      float buffer[FRAMES * 2];
+      EventMap::const_iterator playPos = events.cbegin();
+      EventMap::const_iterator endPos  = events.cend();
+      --endPos;
+      const int et = (score->utick2utime(endPos->first) + 1) * MScore::sampleRate;
+      int playTime = 0;
+
+      QElapsedTimer timer;
+      timer.start();
+      while (playTime < et) {
+            AudioProfilePeriod period(prof, FRAMES, MScore::sampleRate);
+            renderPeriod(score, synti, events, playPos, playTime, buffer, FRAMES);
+            }
+      double renderTime = timer.nsecsElapsed() * 1e-9;
+      double audioTime  = double(playTime) / MScore::sampleRate;
+
+      QTextStream os(&file);
+      os << QString("audio: %1 s at %2 Hz, rendered in %3 s, realtime factor %4\n")
+            .arg(audioTime, 0, 'f', 2)
+            .arg(sampleRate)
+            .arg(renderTime, 0, 'f', 3)
+            .arg(renderTime > 0.0 ? audioTime / renderTime : 0.0, 0, 'f', 1);
+      os << prof->stats().toString();
+      os.flush();
+      file.close();
+
+      MScore::sampleRate = oldSampleRate;
+      delete synti;
+      return file.error() == QFile::NoError;
+      }
+
 #ifdef HAS_AUDIOFILE
 
 
@@ -1503,6 +1503,7 @@ QString MuseScore::getDrumsetFilename(bool open)
 void MuseScore::printFile()
       {
 #ifndef QT_NO_PRINTER
+      cs->doPendingLayout();
       LayoutMode layoutMode = cs->layoutMode();
       if (layoutMode != LayoutMode::PAGE) {
             cs->setLayoutMode(LayoutMode::PAGE);
@@ -1806,6 +1807,7 @@ bool MuseScore::exportParts()
 bool MuseScore::saveAs(Score* cs, bool saveCopy, const QString& path, const QString& ext)
       {
       bool rv = false;
+      cs->doPendingLayout();
       QString suffix = "." + ext;
       QString fn(path);
       if (!fn.endsWith(suffix))
@@ -1924,6 +1926,7 @@ bool MuseScore::savePdf(const QString& saveName)
 
 bool MuseScore::savePdf(Score* cs, const QString& saveName)
       {
+      cs->doPendingLayout();
       cs->setPrinting(true);
       MScore::pdfPrinting = true;
 
@@ -1983,6 +1986,8 @@ bool MuseScore::savePdf(QList<Score*> cs, const QString& saveName)
       {
       if (cs.empty())
             return false;
+      for (Score* s : cs)
+            s->doPendingLayout();
       Score* firstScore = cs[0];
 
       QPdfWriter pdfWriter(saveName);
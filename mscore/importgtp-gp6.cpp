@@ -123,7 +123,9 @@ int GuitarPro6::readBit() {
       // calculate our offset so we know how much to bit shift
       int byteOffset = ((BITS_IN_BYTE-1) - (this->position % BITS_IN_BYTE));
       // calculate the bit which we want to read
-      int bit = ((((*buffer)[byteIndex] & 0xff) >> byteOffset) & 0x01);
+      // reading past the end of the stream yields zero bits
+      char byte = byteIndex < buffer->size() ? buffer->constData()[byteIndex] : 0;
+      int bit = (((byte & 0xff) >> byteOffset) & 0x01);
       // increment our curent position so we know this bit has been read
       this->position++;
       // return the bit we calculated
@@ -214,8 +216,10 @@ void GuitarPro6::readGPX(QByteArray* buffer) {
       if (fileHeader == GPX_HEADER_COMPRESSED) {
             // this is  a compressed file.
             int length = readInteger(buffer, this->position/BITS_IN_BYTE);
+            // the decompressed size is known up front, so the output is
+            // allocated once and back references copy from it in place
             QByteArray* bcfsBuffer = new QByteArray();
-            int positionCounter = 0;
+            bcfsBuffer->reserve(qMax(length, 0));
             while(!f->error() && (this->position/this->BITS_IN_BYTE) < length) {
                   // read the bit indicating compression information
                   int flag = this->readBits(1);
@@ -225,19 +229,18 @@ void GuitarPro6::readGPX(QByteArray* buffer) {
                         int offs = this->readBitsReversed(bits);
                         int size = this->readBitsReversed(bits);
 
-                        QByteArray bcfsBufferCopy = *bcfsBuffer;
-                        int pos = (bcfsBufferCopy.length() - offs );
-                        for( int i = 0; i < (size > offs ? offs : size) ; i ++ ) {
-                              bcfsBuffer->insert(positionCounter, bcfsBufferCopy[pos + i] ) ;
-                              positionCounter++;
+                        // at most offs bytes are copied, so the source never
+                        // overlaps the bytes appended here
+                        int pos = (bcfsBuffer->length() - offs );
+                        if (pos >= 0) {
+                              for( int i = 0; i < (size > offs ? offs : size) ; i ++ )
+                                    bcfsBuffer->append(bcfsBuffer->at(pos + i));
                               }
                         }
                   else  {
                         int size = this->readBitsReversed(2);
-                        for(int i = 0; i < size; i++) {
-                              bcfsBuffer->insert(positionCounter, this->readBits(8));
-                              positionCounter++;
-                              }
+                        for(int i = 0; i < size; i++)
+                              bcfsBuffer->append(char(this->readBits(8)));
                         }
                   }
              // recurse on the decompressed file stored as a byte array
@@ -542,17 +545,30 @@ void GuitarPro6::readTracks(QDomNode* track)
 //   getNode
 //---------------------------------------------------------
 
-QDomNode GuitarPro6::getNode(QString id, QDomNode currentNode)
+QDomNode GuitarPro6::getNode(const QString& id, const QHash<QString, QDomNode>& nodes)
       {
-      while (!(currentNode).isNull()) {
-            QString currentId = currentNode.attributes().namedItem("id").toAttr().value();
-            if (id.compare(currentId) == 0) {
-                  return currentNode;
-                  }
-            currentNode = (currentNode).nextSibling();
-            }
+      auto i = nodes.constFind(id);
+      if (i != nodes.constEnd())
+            return i.value();
       qDebug() << "WARNING: A null node was returned when search for the identifier" << id << ". Your Guitar Pro file may be corrupted.";
-      return currentNode;
+      return QDomNode();
+      }
+
+//---------------------------------------------------------
+//   indexNodes
+//    map the id attribute of node and its following
+//    siblings to the node; the first one wins
+//---------------------------------------------------------
+
+void GuitarPro6::indexNodes(QDomNode node, QHash<QString, QDomNode>* nodes)
+      {
+      nodes->clear();
+      while (!node.isNull()) {
+            QString id = node.attributes().namedItem("id").toAttr().value();
+            if (!nodes->contains(id))
+                  nodes->insert(id, node);
+            node = node.nextSibling();
+            }
       }
 
 //---------------------------------------------------------
@@ -759,7 +775,7 @@ int GuitarPro6::readBeats(QString beats, GPPartInfo* partInfo, Measure* measure,
 
                   Fraction l;
                   int dotted = 0;
-                  QDomNode beat = getNode(*currentBeat, partInfo->beats);
+                  QDomNode beat = getNode(*currentBeat, partInfo->beatsById);
                   int currentTick = startTick + beatsTick;
                   Segment* segment = measure->getSegment(SegmentType::ChordRest, currentTick);
                   QDomNode currentNode = beat.firstChild();
@@ -797,7 +813,7 @@ int GuitarPro6::readBeats(QString beats, GPPartInfo* partInfo, Measure* measure,
 
                               for (auto iter = notesList.begin(); iter != notesList.end(); ++iter) {
                                     // we have found a note
-                                    QDomNode note = getNode(*iter, partInfo->notes);
+                                    QDomNode note = getNode(*iter, partInfo->notesById);
                                     QDomNode currentNote = (note).firstChild();
                                     bool tie = false;
                                     bool trill = false;
@@ -1312,7 +1328,7 @@ int GuitarPro6::readBeats(QString beats, GPPartInfo* partInfo, Measure* measure,
                         else if (currentNode.nodeName() == "Rhythm") {
                               // we have found a rhythm
                               QString refString = currentNode.attributes().namedItem("ref").toAttr().value();
-                              QDomNode rhythm = getNode(refString, partInfo->rhythms);
+                              QDomNode rhythm = getNode(refString, partInfo->rhythmsById);
                               QDomNode currentNode = (rhythm).firstChild();
                               while (!currentNode.isNull()) {
                                     if (currentNode.nodeName() == "NoteValue") {
@@ -1441,7 +1457,7 @@ void GuitarPro6::readBars(QDomNode* barList, Measure* measure, ClefType oldClefI
       for (auto iter = barsString.begin(); iter != barsString.end(); ++iter) {
             int tick = measure->tick();
 
-            QDomNode barNode = getNode(*iter, partInfo->bars);
+            QDomNode barNode = getNode(*iter, partInfo->barsById);
             QDomNode currentNode = (barNode).firstChild();
             QDomNode voice;
             while (!currentNode.isNull()) {
@@ -1527,7 +1543,7 @@ void GuitarPro6::readBars(QDomNode* barList, Measure* measure, ClefType oldClefI
                         for (auto currentVoice : voices) {
                               // if the voice is not -1 then we set voice
                               if (currentVoice.compare("-1"))
-                                    voice = getNode(currentVoice, partInfo->voices);
+                                    voice = getNode(currentVoice, partInfo->voicesById);
                               voiceNum +=1;
                               if (currentVoice.toInt() == - 1) {
                                     if (contentAdded) continue;
@@ -1908,6 +1924,11 @@ void GuitarPro6::readGpif(QByteArray* data)
       partInfo.beats = beats.firstChild();
       partInfo.notes = notes.firstChild();
       partInfo.rhythms = rhythms.firstChild();
+      indexNodes(partInfo.bars, &partInfo.barsById);
+      indexNodes(partInfo.voices, &partInfo.voicesById);
+      indexNodes(partInfo.beats, &partInfo.beatsById);
+      indexNodes(partInfo.notes, &partInfo.notesById);
+      indexNodes(partInfo.rhythms, &partInfo.rhythmsById);
 
       measures = findNumMeasures(&partInfo);
 
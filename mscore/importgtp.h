@@ -350,6 +350,12 @@ class GuitarPro6 : public GuitarPro {
             QDomNode beats;
             QDomNode notes;
             QDomNode rhythms;
+            // the children of the sections above, indexed by their id attribute
+            QHash<QString, QDomNode> barsById;
+            QHash<QString, QDomNode> voicesById;
+            QHash<QString, QDomNode> beatsById;
+            QHash<QString, QDomNode> notesById;
+            QHash<QString, QDomNode> rhythmsById;
             };
       // a mapping from identifiers to fret diagrams by tracks
       QMap<int, QMap<int, FretDiagram*>> fretDiagrams;
@@ -374,7 +380,8 @@ class GuitarPro6 : public GuitarPro {
       void readMasterBars(GPPartInfo* partInfo);
       Fraction rhythmToDuration(QString value);
       Fraction fermataToFraction(int numerator, int denominator);
-      QDomNode getNode(QString id, QDomNode nodes);
+      QDomNode getNode(const QString& id, const QHash<QString, QDomNode>& nodes);
+      void indexNodes(QDomNode node, QHash<QString, QDomNode>* nodes);
       void unhandledNode(QString nodeName);
       void makeTie(Note* note);
       int* previousDynamic;
@@ -28,6 +28,7 @@
 #include "importmxml.h"
 #include "importmxmlpass1.h"
 #include "importmxmlpass2.h"
+#include "importmxmlreader.h"
 #include "preferences.h"
 
 namespace Ms {
@@ -37,17 +38,20 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
       //qDebug("importMusicXMLfromBuffer(score %p, name '%s', dev %p)",
       //       score, qPrintable(name), dev);
 
-      // pass 1
+      // tokenize the document once, both passes replay the events
       dev->seek(0);
+      MxmlEventBuffer events;
+      events.read(dev);
+
+      // pass 1
       MusicXMLParserPass1 pass1(score);
-      Score::FileError res = pass1.parse(dev);
+      Score::FileError res = pass1.parse(events);
       if (res != Score::FileError::FILE_NO_ERROR)
             return res;
 
       // pass 2
-      dev->seek(0);
       MusicXMLParserPass2 pass2(score, pass1);
-      return pass2.parse(dev);
+      return pass2.parse(events);
       }
 
 } // namespace Ms
@@ -846,14 +846,14 @@ static void doCredits(Score* score, const CreditWordsList& credits, const int pa
 //---------------------------------------------------------
 
 /**
- Parse MusicXML in \a device and extract pass 1 data.
+ Parse the MusicXML events in \a buffer and extract pass 1 data.
  */
 
-Score::FileError MusicXMLParserPass1::parse(QIODevice* device)
+Score::FileError MusicXMLParserPass1::parse(const MxmlEventBuffer& buffer)
       {
-      logDebugTrace("MusicXMLParserPass1::parse device");
+      logDebugTrace("MusicXMLParserPass1::parse buffer");
       _parts.clear();
-      _e.setDevice(device);
+      _e.setBuffer(&buffer);
       Score::FileError res = parse();
       if (res != Score::FileError::FILE_NO_ERROR)
             return res;
@@ -1160,7 +1160,7 @@ static QString decodeEntities( const QString& src )
  Read the next part of a MusicXML formatted string and convert to MuseScore internal encoding.
  */
 
-static QString nextPartOfFormattedString(QXmlStreamReader& e)
+static QString nextPartOfFormattedString(MxmlStreamReader& e)
       {
       //QString lang       = e.attribute(QString("xml:lang"), "it");
       QString fontWeight = e.attributes().value("font-weight").toString();
@@ -22,6 +22,7 @@
 
 #include "libmscore/score.h"
 #include "importxmlfirstpass.h"
+#include "importmxmlreader.h"
 #include "musicxml.h" // for the creditwords and MusicXmlPartGroupList definitions
 #include "musicxmlsupport.h"
 
@@ -64,7 +65,7 @@ class MusicXMLParserPass1 {
 public:
       MusicXMLParserPass1(Score* score);
       void initPartState(const QString& partId);
-      Score::FileError parse(QIODevice* device);
+      Score::FileError parse(const MxmlEventBuffer& buffer);
       Score::FileError parse();
       void scorePartwise();
       void identification();
@@ -119,7 +120,7 @@ private:
       void setFirstInstr(const QString& id, const Fraction stime);
 
       // generic pass 1 data
-      QXmlStreamReader _e;
+      MxmlStreamReader _e;
       int _divs;                                ///< Current MusicXML divisions value
       QMap<QString, MusicXmlPart> _parts;       ///< Parts data, mapped on part id
       QVector<Fraction> _measureLength;         ///< Length of each measure
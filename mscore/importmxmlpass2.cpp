@@ -686,7 +686,7 @@ static QString decodeEntities( const QString& src )
  Read the next part of a MusicXML formatted string and convert to MuseScore internal encoding.
  */
 
-static QString nextPartOfFormattedString(QXmlStreamReader& e)
+static QString nextPartOfFormattedString(MxmlStreamReader& e)
       {
       //QString lang       = e.attribute(QString("xml:lang"), "it");
       QString fontWeight = e.attributes().value("font-weight").toString();
@@ -1604,13 +1604,13 @@ void MusicXMLParserPass2::skipLogCurrElem()
 //---------------------------------------------------------
 
 /**
- Parse MusicXML in \a device and extract pass 2 data.
+ Parse the MusicXML events in \a buffer and extract pass 2 data.
  */
 
-Score::FileError MusicXMLParserPass2::parse(QIODevice* device)
+Score::FileError MusicXMLParserPass2::parse(const MxmlEventBuffer& buffer)
       {
       //qDebug("MusicXMLParserPass2::parse()");
-      _e.setDevice(device);
+      _e.setBuffer(&buffer);
       Score::FileError res = parse();
       //qDebug("MusicXMLParserPass2::parse() res %d", int(res));
       return res;
@@ -4007,7 +4007,7 @@ static Chord* createGraceChord(Score* score, const int track,
  until after allocating the note.
  */
 
-static bool elementMustBePostponed(const QXmlStreamReader& e)
+static bool elementMustBePostponed(const MxmlStreamReader& e)
       {
       return e.name() == "notations"
              || e.name() == "lyric"
@@ -4043,7 +4043,7 @@ static void handleDisplayStep(ChordRest* cr, int step, int octave, int tick, qre
  Handle <display-step> and <display-octave> for <rest> and <unpitched>
  */
 
-static void displayStepOctave(QXmlStreamReader& e,
+static void displayStepOctave(MxmlStreamReader& e,
                               int& step,
                               int& oct)
       {
@@ -6015,7 +6015,7 @@ void MusicXMLParserPass2::tuplet(MusicXmlTupletDesc& tupletDesc)
  MusicXMLParserDirection constructor.
  */
 
-MusicXMLParserDirection::MusicXMLParserDirection(QXmlStreamReader& e,
+MusicXMLParserDirection::MusicXMLParserDirection(MxmlStreamReader& e,
                                                  Score* score,
                                                  const MusicXMLParserPass1& pass1,
                                                  MusicXMLParserPass2& pass2)
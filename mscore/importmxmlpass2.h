@@ -102,7 +102,7 @@ class MusicXMLParserPass2 {
 public:
       MusicXMLParserPass2(Score* score, MusicXMLParserPass1& pass1);
       void initPartState(const QString& partId);
-      Score::FileError parse(QIODevice* device);
+      Score::FileError parse(const MxmlEventBuffer& buffer);
       Score::FileError parse();
       void scorePartwise();
       void partList();
@@ -162,7 +162,7 @@ public:
 private:
       // generic pass 2 data
 
-      QXmlStreamReader _e;
+      MxmlStreamReader _e;
       int _divs;                          // the current divisions value
       QString _parseStatus;               // the parse status (typicallay a short error message)
       Score* const _score;                // the score
@@ -208,14 +208,14 @@ private:
 
 class MusicXMLParserDirection {
 public:
-      MusicXMLParserDirection(QXmlStreamReader& e, Score* score, const MusicXMLParserPass1& pass1, MusicXMLParserPass2& pass2);
+      MusicXMLParserDirection(MxmlStreamReader& e, Score* score, const MusicXMLParserPass1& pass1, MusicXMLParserPass2& pass2);
       void direction(const QString& partId, Measure* measure, const int tick, MusicXmlSpannerMap& spanners);
       void logError(const QString& error);
       void logDebugInfo(const QString& info);
       void skipLogCurrElem();
 
 private:
-      QXmlStreamReader& _e;
+      MxmlStreamReader& _e;
       Score* const _score;                      // the score
       const MusicXMLParserPass1& _pass1;        // the pass1 results
       MusicXMLParserPass2& _pass2;              // the pass2 results
@@ -0,0 +1,300 @@
+//=============================================================================
+//  MuseScore
+//  Linux Music Score Editor
+//
+//  Copyright (C) 2017 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "importmxmlreader.h"
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   intern
+//---------------------------------------------------------
+
+/**
+ Return the index of string \a s in the string pool, adding it if necessary.
+ */
+
+int MxmlEventBuffer::intern(const QStringRef& s)
+      {
+      const QString str = s.toString();
+      auto i = _stringIndex.constFind(str);
+      if (i != _stringIndex.constEnd())
+            return i.value();
+      int idx = _strings.size();
+      _strings.append(str);
+      _stringIndex.insert(str, idx);
+      return idx;
+      }
+
+//---------------------------------------------------------
+//   read
+//---------------------------------------------------------
+
+/**
+ Tokenize the XML document in \a device into the event buffer.
+ On a parse error the buffer ends at the offending token, as a
+ QXmlStreamReader reading the same document would.
+ */
+
+void MxmlEventBuffer::read(QIODevice* device)
+      {
+      _events.clear();
+      _attrs.clear();
+      _strings.clear();
+      _stringIndex.clear();
+      _errorString.clear();
+      intern(QStringRef());         // index 0 is the empty string
+
+      QXmlStreamReader e(device);
+      while (!e.atEnd()) {
+            QXmlStreamReader::TokenType type = e.readNext();
+            if (type == QXmlStreamReader::Invalid)
+                  break;
+            Event ev;
+            ev.type   = type;
+            ev.str    = 0;
+            ev.attr   = int(_attrs.size());
+            ev.nattr  = 0;
+            ev.line   = int(e.lineNumber());
+            ev.column = int(e.columnNumber());
+            switch (type) {
+                  case QXmlStreamReader::StartElement:
+                        ev.str = intern(e.name());
+                        for (const QXmlStreamAttribute& a : e.attributes()) {
+                              _attrs.push_back({ intern(a.qualifiedName()), intern(a.value()) });
+                              ++ev.nattr;
+                              }
+                        break;
+                  case QXmlStreamReader::EndElement:
+                        ev.str = intern(e.name());
+                        break;
+                  case QXmlStreamReader::Characters:
+                  case QXmlStreamReader::EntityReference:
+                  case QXmlStreamReader::Comment:
+                        ev.str = intern(e.text());
+                        break;
+                  default:
+                        break;
+                  }
+            _events.push_back(ev);
+            }
+      if (e.hasError())
+            _errorString = e.errorString();
+      }
+
+//---------------------------------------------------------
+//   setBuffer
+//---------------------------------------------------------
+
+void MxmlStreamReader::setBuffer(const MxmlEventBuffer* buffer)
+      {
+      _buffer        = buffer;
+      _pos           = -1;
+      _type          = QXmlStreamReader::NoToken;
+      _attributesPos = -1;
+      _errorString.clear();
+      }
+
+//---------------------------------------------------------
+//   readNext
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType MxmlStreamReader::readNext()
+      {
+      if (_type == QXmlStreamReader::Invalid)
+            return _type;
+      if (!_buffer || _pos + 1 >= _buffer->size()) {
+            _pos  = _buffer ? _buffer->size() : 0;
+            _type = QXmlStreamReader::Invalid;
+            if (_buffer && _buffer->hasError())
+                  _errorString = _buffer->errorString();
+            return _type;
+            }
+      ++_pos;
+      _type = _buffer->event(_pos).type;
+      return _type;
+      }
+
+//---------------------------------------------------------
+//   readNextStartElement
+//---------------------------------------------------------
+
+bool MxmlStreamReader::readNextStartElement()
+      {
+      while (readNext() != QXmlStreamReader::Invalid) {
+            if (isEndElement())
+                  return false;
+            else if (isStartElement())
+                  return true;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   readElementText
+//---------------------------------------------------------
+
+/**
+ Read the character data of the current element, leaving the reader
+ on its end element. Like QXmlStreamReader with the default
+ ErrorOnUnexpectedElement behavior, a child element is an error.
+ */
+
+QString MxmlStreamReader::readElementText()
+      {
+      QString result;
+      if (!isStartElement())
+            return result;
+      for (;;) {
+            switch (readNext()) {
+                  case QXmlStreamReader::Characters:
+                  case QXmlStreamReader::EntityReference:
+                        result += _buffer->string(_buffer->event(_pos).str);
+                        break;
+                  case QXmlStreamReader::EndElement:
+                  case QXmlStreamReader::Invalid:
+                        return result;
+                  case QXmlStreamReader::ProcessingInstruction:
+                  case QXmlStreamReader::Comment:
+                        break;
+                  case QXmlStreamReader::StartElement:
+                        _errorString = QString("Expected character data.");
+                        _type = QXmlStreamReader::Invalid;
+                        return result;
+                  default:
+                        break;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   skipCurrentElement
+//---------------------------------------------------------
+
+void MxmlStreamReader::skipCurrentElement()
+      {
+      int depth = 1;
+      while (depth && readNext() != QXmlStreamReader::Invalid) {
+            if (isEndElement())
+                  --depth;
+            else if (isStartElement())
+                  ++depth;
+            }
+      }
+
+//---------------------------------------------------------
+//   tokenString
+//---------------------------------------------------------
+
+QString MxmlStreamReader::tokenString() const
+      {
+      switch (_type) {
+            case QXmlStreamReader::NoToken:               return "NoToken";
+            case QXmlStreamReader::Invalid:               return "Invalid";
+            case QXmlStreamReader::StartDocument:         return "StartDocument";
+            case QXmlStreamReader::EndDocument:           return "EndDocument";
+            case QXmlStreamReader::StartElement:          return "StartElement";
+            case QXmlStreamReader::EndElement:            return "EndElement";
+            case QXmlStreamReader::Characters:            return "Characters";
+            case QXmlStreamReader::Comment:               return "Comment";
+            case QXmlStreamReader::DTD:                   return "DTD";
+            case QXmlStreamReader::EntityReference:       return "EntityReference";
+            case QXmlStreamReader::ProcessingInstruction: return "ProcessingInstruction";
+            }
+      return QString();
+      }
+
+//---------------------------------------------------------
+//   name
+//---------------------------------------------------------
+
+QStringRef MxmlStreamReader::name() const
+      {
+      if (isStartElement() || isEndElement())
+            return QStringRef(&_buffer->string(_buffer->event(_pos).str));
+      return QStringRef();
+      }
+
+//---------------------------------------------------------
+//   text
+//---------------------------------------------------------
+
+QStringRef MxmlStreamReader::text() const
+      {
+      switch (_type) {
+            case QXmlStreamReader::Characters:
+            case QXmlStreamReader::EntityReference:
+            case QXmlStreamReader::Comment:
+                  return QStringRef(&_buffer->string(_buffer->event(_pos).str));
+            default:
+                  return QStringRef();
+            }
+      }
+
+//---------------------------------------------------------
+//   attributes
+//---------------------------------------------------------
+
+/**
+ Return the attributes of the current start element.
+ They are built from the string pool the first time they are requested.
+ */
+
+const QXmlStreamAttributes& MxmlStreamReader::attributes() const
+      {
+      if (_attributesPos != _pos) {
+            _attributes.clear();
+            if (isStartElement()) {
+                  const MxmlEventBuffer::Event& ev = _buffer->event(_pos);
+                  for (int i = ev.attr; i < ev.attr + ev.nattr; ++i) {
+                        const MxmlEventBuffer::Attr& a = _buffer->attr(i);
+                        _attributes.append(_buffer->string(a.name), _buffer->string(a.value));
+                        }
+                  }
+            _attributesPos = _pos;
+            }
+      return _attributes;
+      }
+
+//---------------------------------------------------------
+//   lineNumber
+//---------------------------------------------------------
+
+qint64 MxmlStreamReader::lineNumber() const
+      {
+      if (!_buffer || _pos < 0)
+            return 0;
+      if (_pos >= _buffer->size())
+            return _buffer->size() ? _buffer->event(_buffer->size() - 1).line : 0;
+      return _buffer->event(_pos).line;
+      }
+
+//---------------------------------------------------------
+//   columnNumber
+//---------------------------------------------------------
+
+qint64 MxmlStreamReader::columnNumber() const
+      {
+      if (!_buffer || _pos < 0)
+            return 0;
+      if (_pos >= _buffer->size())
+            return _buffer->size() ? _buffer->event(_buffer->size() - 1).column : 0;
+      return _buffer->event(_pos).column;
+      }
+
+} // namespace Ms
@@ -0,0 +1,111 @@
+//=============================================================================
+//  MuseScore
+//  Linux Music Score Editor
+//
+//  Copyright (C) 2017 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef __IMPORTMXMLREADER_H__
+#define __IMPORTMXMLREADER_H__
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   MxmlEventBuffer
+//---------------------------------------------------------
+
+/**
+ The MusicXML document tokenized once into a flat list of events.
+ Element names, attribute names and values and character data
+ are interned in a single string pool, which keeps the buffer
+ compact for the highly repetitive MusicXML vocabulary.
+ */
+
+class MxmlEventBuffer {
+public:
+      struct Event {
+            QXmlStreamReader::TokenType type;
+            int str;                ///< Element name or text, index into the string pool
+            int attr;               ///< First attribute, index into _attrs
+            int nattr;              ///< Number of attributes
+            int line;
+            int column;
+            };
+      struct Attr {
+            int name;               ///< Index into the string pool
+            int value;              ///< Index into the string pool
+            };
+
+      void read(QIODevice* device);
+      int size() const                          { return int(_events.size()); }
+      const Event& event(int i) const           { return _events[i]; }
+      const Attr& attr(int i) const             { return _attrs[i]; }
+      const QString& string(int i) const        { return _strings[i]; }
+      bool hasError() const                     { return !_errorString.isEmpty(); }
+      QString errorString() const               { return _errorString; }
+
+private:
+      int intern(const QStringRef& s);
+
+      std::vector<Event> _events;
+      std::vector<Attr> _attrs;
+      QVector<QString> _strings;                ///< String pool
+      QHash<QString, int> _stringIndex;         ///< String pool lookup
+      QString _errorString;                     ///< Parse error that ended tokenization
+      };
+
+//---------------------------------------------------------
+//   MxmlStreamReader
+//---------------------------------------------------------
+
+/**
+ Replays an MxmlEventBuffer through the subset of the QXmlStreamReader
+ interface used by the MusicXML importer, so that both passes share a
+ single tokenization of the document.
+ */
+
+class MxmlStreamReader {
+public:
+      MxmlStreamReader() {}
+      void setBuffer(const MxmlEventBuffer* buffer);
+
+      QXmlStreamReader::TokenType readNext();
+      bool readNextStartElement();
+      QString readElementText();
+      void skipCurrentElement();
+
+      QXmlStreamReader::TokenType tokenType() const { return _type; }
+      QString tokenString() const;
+      bool isStartElement() const               { return _type == QXmlStreamReader::StartElement; }
+      bool isEndElement() const                 { return _type == QXmlStreamReader::EndElement; }
+      QStringRef name() const;
+      QStringRef text() const;
+      const QXmlStreamAttributes& attributes() const;
+      qint64 lineNumber() const;
+      qint64 columnNumber() const;
+      bool hasError() const                     { return !_errorString.isEmpty(); }
+      QString errorString() const               { return _errorString; }
+
+private:
+      const MxmlEventBuffer* _buffer { 0 };
+      int _pos { -1 };                          ///< Current event
+      QXmlStreamReader::TokenType _type { QXmlStreamReader::NoToken };
+      QString _errorString;
+      mutable QXmlStreamAttributes _attributes; ///< Attributes of the current element, built on demand
+      mutable int _attributesPos { -1 };        ///< Event _attributes belongs to
+      };
+
+} // namespace Ms
+#endif
@@ -173,36 +173,58 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 
 
 //---------------------------------------------------------
-//   doValidate
+//   validateMusicXml
 //---------------------------------------------------------
 
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Validate MusicXML \a data from file \a name against the MusicXML schema.
+ The schema is compiled on first use and kept for the lifetime of the process.
+ Sets \a valid and returns the validator messages in \a errors.
+ Returns FILE_BAD_FORMAT if the schema itself could not be loaded.
+ May be called from any thread.
  */
 
-static Score::FileError doValidate(const QString& name, QIODevice* dev)
+static Score::FileError validateMusicXml(const QString& name, const QByteArray& data, bool& valid, QString& errors)
       {
-      QTime t;
-      t.start();
+      // QXmlSchema is reentrant but not thread safe, uses of the shared instance are serialized
+      static QMutex schemaMutex;
+      static QXmlSchema* schema = 0;
+
+      QMutexLocker locker(&schemaMutex);
+      if (!schema) {
+            QXmlSchema* s = new QXmlSchema;
+            if (!initMusicXmlSchema(*s)) {
+                  delete s;
+                  return Score::FileError::FILE_BAD_FORMAT;  // appropriate error message has been printed by initMusicXmlSchema
+                  }
+            schema = s;
+            }
 
-      // initialize the schema
       ValidatorMessageHandler messageHandler;
-      QXmlSchema schema;
-      schema.setMessageHandler(&messageHandler);
-      if (!initMusicXmlSchema(schema))
-            return Score::FileError::FILE_BAD_FORMAT;  // appropriate error message has been printed by initMusicXmlSchema
+      QXmlSchemaValidator validator(*schema);
+      validator.setMessageHandler(&messageHandler);
+      valid  = validator.validate(data, QUrl::fromLocalFile(name));
+      errors = messageHandler.getErrors();
+      return Score::FileError::FILE_NO_ERROR;
+      }
+
+//---------------------------------------------------------
+//   validationResult
+//---------------------------------------------------------
 
-      // validate the data
-      QXmlSchemaValidator validator(schema);
-      bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
-      //qDebug("Validation time elapsed: %d ms", t.elapsed());
+/**
+ Report the outcome of validating file \a name and, if the file
+ is invalid, ask the user whether to load it anyway.
+ */
 
+static Score::FileError validationResult(const QString& name, bool valid, const QString& errors)
+      {
       if (!valid) {
             qDebug("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
             MScore::lastError = QObject::tr("File '%1' is not a valid MusicXML file").arg(name);
             if (MScore::noGui)
                   return Score::FileError::FILE_NO_ERROR;   // might as well try anyhow in converter mode
-            if (musicXMLValidationErrorDialog(MScore::lastError, messageHandler.getErrors()) != QMessageBox::Yes)
+            if (musicXMLValidationErrorDialog(MScore::lastError, errors) != QMessageBox::Yes)
                   return Score::FileError::FILE_USER_ABORT;
             }
 
@@ -216,6 +238,8 @@ static Score::FileError doValidate(const QString& name, QIODevice* dev)
 
 /**
  Validate and import MusicXML data from file \a name contained in QIODevice \a dev into score \a score.
+ In converter mode an invalid file is imported anyway, so validation
+ runs on a worker thread while the import parses the data.
  */
 
 static Score::FileError doValidateAndImport(Score* score, const QString& name, QIODevice* dev)
@@ -223,9 +247,33 @@ static Score::FileError doValidateAndImport(Score* score, const QString& name, Q
       // verify tuplet TDuration::DurationType dependencies
       tupletAssert();
 
-      // validate the file
+      if (MScore::skipXmlValidation) {
+            importMusicXMLfromBuffer(score, name, dev);
+            return Score::FileError::FILE_NO_ERROR;
+            }
+
+      dev->seek(0);
+      const QByteArray data = dev->readAll();
+      bool valid = true;
+      QString errors;
       Score::FileError res;
-      res = doValidate(name, dev);
+
+      if (MScore::noGui) {
+            QFuture<Score::FileError> validation = QtConcurrent::run([name, data, &valid, &errors]() {
+                  return validateMusicXml(name, data, valid, errors);
+                  });
+            importMusicXMLfromBuffer(score, name, dev);
+            res = validation.result();
+            if (res != Score::FileError::FILE_NO_ERROR)
+                  return res;
+            return validationResult(name, valid, errors);
+            }
+
+      // validate the file
+      res = validateMusicXml(name, data, valid, errors);
+      if (res != Score::FileError::FILE_NO_ERROR)
+            return res;
+      res = validationResult(name, valid, errors);
       if (res != Score::FileError::FILE_NO_ERROR)
             return res;
 
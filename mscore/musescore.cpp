@@ -1342,6 +1342,9 @@ MuseScore::MuseScore()
       autoSaveTimer = new QTimer(this);
       autoSaveTimer->setSingleShot(true);
       connect(autoSaveTimer, SIGNAL(timeout()), this, SLOT(autoSaveTimerTimeout()));
+      partLayoutTimer = new QTimer(this);
+      partLayoutTimer->setSingleShot(true);
+      connect(partLayoutTimer, SIGNAL(timeout()), this, SLOT(partLayoutTimerTimeout()));
       initOsc();
       startAutoSave();
 
@@ -1595,6 +1598,8 @@ void MuseScore::selectionChanged(SelState selectionState)
             drumrollEditor->changeSelection(selectionState);
       if (timeline())
             timeline()->changeSelection(selectionState);
+      if (navigator())
+            navigator()->selectionChanged();
       updateInspector();
       }
 
@@ -2389,7 +2394,7 @@ void MuseScore::removeTab(int i)
 //   loadTranslation
 //---------------------------------------------------------
 
-void loadTranslation(QString filename, QString localeName)
+QString loadTranslation(QString filename, QString localeName)
       {
       QString userPrefix    = dataPath + "/locale/"+ filename +"_";
       QString defaultPrefix = mscoreGlobalShare + "locale/"+ filename +"_";
@@ -2427,12 +2432,12 @@ void loadTranslation(QString filename, QString localeName)
       if (success) {
             qApp->installTranslator(translator);
             translatorList.append(translator);
+            return lp;
             }
-      else {
-            if (MScore::debugMode)
-                  qDebug("load translator <%s> failed", qPrintable(lp));
-            delete translator;
-            }
+      if (MScore::debugMode)
+            qDebug("load translator <%s> failed", qPrintable(lp));
+      delete translator;
+      return QString();
       }
 
 //---------------------------------------------------------
@@ -2463,7 +2468,14 @@ void setMscoreLocale(QString localeName)
       // find the most recent translation file
       // try to replicate QTranslator.load algorithm in our particular case
       loadTranslation("mscore", localeName);
-      loadTranslation("instruments", localeName);
+      QString instrumentsTranslation = loadTranslation("instruments", localeName);
+
+      // cached instrument templates hold translated names
+      if (!instrumentsTranslation.isEmpty()) {
+            QFileInfo fi(instrumentsTranslation + ".qm");
+            instrumentsTranslation += fi.lastModified().toString(Qt::ISODate);
+            }
+      setInstrumentTemplateCache(dataPath + "/cache", instrumentsTranslation);
 
       QString resourceDir;
 #if defined(Q_OS_MAC) || defined(Q_OS_WIN)
@@ -2569,6 +2581,30 @@ static void loadScores(const QStringList& argv)
       mscore->setCurrentView(1, currentScoreView);
       }
 
+//---------------------------------------------------------
+//   createScoreParts
+//    create parts for all visible instruments
+//    if the score has none yet
+//---------------------------------------------------------
+
+static void createScoreParts(Score* cs)
+      {
+      if (!cs->excerpts().isEmpty())
+            return;
+      auto excerpts = Excerpt::createAllExcerpt(cs->masterScore());
+
+      cs->startCmd();
+      for (Excerpt* e : excerpts) {
+            Score* nscore = new Score(e->oscore());
+            e->setPartScore(nscore);
+            nscore->setExcerpt(e);
+            nscore->style().set(StyleIdx::createMultiMeasureRests, true);
+            Excerpt::createExcerpt(e);
+            cs->undo(new AddExcerpt(e));
+            }
+      cs->endCmd();
+      }
+
 //---------------------------------------------------------
 //   doConvert
 //---------------------------------------------------------
@@ -2628,45 +2664,32 @@ static bool doConvert(Score* cs, QString fn, QString plugin = "")
                   rv = mscore->savePdf(cs, fn);
                   }
             else {
-                  if (cs->excerpts().size() == 0) {
-                        auto excerpts = Excerpt::createAllExcerpt(cs->masterScore());
-
-                        for (Excerpt* e : excerpts) {
-                              Score* nscore = new Score(e->oscore());
-                              e->setPartScore(nscore);
-                              nscore->style().set(StyleIdx::createMultiMeasureRests, true);
-                              Excerpt::createExcerpt(e);
-                              cs->startCmd();
-                              cs->undo(new AddExcerpt(e));
-                              cs->endCmd();
-                              }
-                        }
+                  createScoreParts(cs);
                   QList<Score*> scores;
                   scores.append(cs);
                   for (Excerpt* e : cs->excerpts())
                         scores.append(e->partScore());
-                  return mscore->savePdf(scores, fn);
+                  // score and parts are laid out once while writing the
+                  // combined file, the single part files reuse that layout
+                  if (!mscore->savePdf(scores, fn))
+                        return false;
+                  int idx = 0;
+                  int padding = QString("%1").arg(cs->excerpts().size()).size();
+                  for (Excerpt* e : cs->excerpts()) {
+                        QString suffix = QString("__excerpt__%1.pdf").arg(idx, padding, 10, QLatin1Char('0'));
+                        QString excerptFn = fn.left(fn.size() - 4) + suffix;
+                        if (!mscore->savePdf(e->partScore(), excerptFn))
+                              return false;
+                        idx++;
+                        }
+                  return true;
                   }
             }
       else if (fn.endsWith(".png")) {
             if (!exportScoreParts)
                   return mscore->savePng(cs, fn);
             else {
-                  if (cs->excerpts().size() == 0) {
-                        auto excerpts = Excerpt::createAllExcerpt(cs->masterScore());
-
-                        for (Excerpt* e: excerpts) {
-                              Score* nscore = new Score(e->oscore());
-                              e->setPartScore(nscore);
-                              nscore->setExcerpt(e);
-                              // nscore->setName(e->title()); // needed before AddExcerpt
-                              nscore->style().set(StyleIdx::createMultiMeasureRests, true);
-                              Excerpt::createExcerpt(e);
-                              cs->startCmd();
-                              cs->undo(new AddExcerpt(e));
-                              cs->endCmd();
-                              }
-                        }
+                  createScoreParts(cs);
                   if (!mscore->savePng(cs, fn))
                         return false;
                   int idx = 0;
@@ -2700,6 +2723,8 @@ static bool doConvert(Score* cs, QString fn, QString plugin = "")
             }
       else if (fn.endsWith(".mlog"))
             return cs->sanityCheck(fn);
+      else if (fn.endsWith(".aprof"))
+            return mscore->saveAudioProfile(cs, fn);
       else if (plugin.isEmpty()) {
             qDebug("don't know how to convert to %s", qPrintable(outFileName));
             return false;
@@ -3974,6 +3999,27 @@ void MuseScore::autoSaveTimerTimeout()
             }
       }
 
+//---------------------------------------------------------
+//   partLayoutTimerTimeout
+//    lay out one part whose layout was deferred by
+//    Score::update() because no view shows it; this runs
+//    in the gui thread between commands, so it never
+//    competes with edits for the score
+//---------------------------------------------------------
+
+void MuseScore::partLayoutTimerTimeout()
+      {
+      for (MasterScore* ms : scoreList) {
+            for (Score* s : ms->scoreList()) {
+                  if (s->layoutPending()) {
+                        s->doPendingLayout();
+                        partLayoutTimer->start(0);    // next part after pending events
+                        return;
+                        }
+                  }
+            }
+      }
+
 //---------------------------------------------------------
 //   restoreSession
 //    Restore last session. If "always" is true, then restore
@@ -4770,6 +4816,7 @@ void MuseScore::endCmd()
             selectionChanged(SelState::NONE);
             }
       updateInspector();
+      partLayoutTimer->start(1000);
       }
 
 //---------------------------------------------------------
@@ -5855,8 +5902,9 @@ int main(int argc, char* av[])
       parser.addOption(QCommandLineOption({"t", "test-mode"}, "Set test mode flag for all files"));
       parser.addOption(QCommandLineOption({"M", "midi-operations"}, "Specify MIDI import operations file", "file"));
       parser.addOption(QCommandLineOption({"w", "no-webview"}, "No web view in start center"));
-      parser.addOption(QCommandLineOption({"P", "export-score-parts"}, "Used with '-o <file>.pdf', export score and parts"));
+      parser.addOption(QCommandLineOption({"P", "export-score-parts"}, "Used with '-o <file>.pdf', export score and parts into one file and each part into its own file"));
       parser.addOption(QCommandLineOption(      "no-fallback-font", "Don't use Bravura as fallback musical font"));
+      parser.addOption(QCommandLineOption(      "skip-validation", "Don't validate imported MusicXML files against the schema"));
       parser.addOption(QCommandLineOption({"f", "force"}, "Used with '-o <file>', ignore warnings reg. score being corrupted or from wrong version"));
       parser.addOption(QCommandLineOption({"b", "bitrate"}, "Used with '-o <file>.mp3', sets bitrate", "bitrate"));
 
@@ -5970,6 +6018,7 @@ int main(int argc, char* av[])
       if (exportScoreParts && !converterMode)
             parser.showHelp(EXIT_FAILURE);
       ignoreWarnings = parser.isSet("f");
+      MScore::skipXmlValidation = parser.isSet("skip-validation");
       if (parser.isSet("b")) {
             QString temp = parser.value("b");
             if (temp.isEmpty())
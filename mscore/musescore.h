@@ -341,6 +341,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       void removeMenuEntry(PluginDescription*);
 
       QTimer* autoSaveTimer;
+      QTimer* partLayoutTimer;            ///< lays out parts not shown in a view while idle
       QList<QAction*> pluginActions;
       QSignalMapper* pluginMapper        { 0 };
 
@@ -463,6 +464,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
    private slots:
       void cmd(QAction* a, const QString& cmd);
       void autoSaveTimerTimeout();
+      void partLayoutTimerTimeout();
       void helpBrowser1() const;
       void resetAndRestart();
       void about();
@@ -663,6 +665,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       bool savePng(Score*, const QString& name, bool screenshot, bool transparent, double convDpi, int trimMargin, QImage::Format format);
       bool saveAudio(Score*, QIODevice *device, std::function<bool(float)> updateProgress = nullptr);
       bool saveAudio(Score*, const QString& name);
+      bool saveAudioProfile(Score*, const QString& name);
       bool canSaveMp3();
       bool saveMp3(Score*, const QString& name);
       bool saveSvg(Score*, const QString& name);
@@ -783,7 +786,7 @@ Driver* driverFactory(Seq*, QString driver);
 
 extern QAction* getAction(const char*);
 extern Shortcut* midiActionMap[128];
-extern void loadTranslation(QString fileName, QString localeName);
+extern QString loadTranslation(QString fileName, QString localeName);
 extern void setMscoreLocale(QString localeName);
 extern bool saveMxl(Score*, const QString& name);
 extern bool saveXml(Score*, const QString& name);
@@ -22,6 +22,9 @@
 
 namespace Ms {
 
+static const int TILE_SIZE  = 1024;           // pixels
+static const int TILE_CACHE = 32 * 1024;      // kB of tile pixmaps
+
 //---------------------------------------------------------
 //   showNavigator
 //---------------------------------------------------------
@@ -124,6 +127,12 @@ Navigator::Navigator(NScrollArea* sa, QWidget* parent)
       sa->setWidget(this);
       sa->setWidgetResizable(false);
       _previewOnly = false;
+
+      renderTimer = new QTimer(this);
+      renderTimer->setSingleShot(true);
+      renderTimer->setInterval(0);
+      connect(renderTimer, SIGNAL(timeout()), this, SLOT(renderPendingTiles()));
+      tiles.setMaxCost(TILE_CACHE);
       }
 
 //---------------------------------------------------------
@@ -149,6 +158,11 @@ void Navigator::setScoreView(ScoreView* v)
             disconnect(_cv, SIGNAL(viewRectChanged()), this, SLOT(updateViewRect()));
             }
       _cv = QPointer<ScoreView>(v);
+      if (!v || v->score() != _score) {
+            tiles.clear();
+            pendingTiles.clear();
+            selectedPages.clear();
+            }
       if (v) {
             _score  = v->score();
             rescale();
@@ -172,6 +186,11 @@ void Navigator::setScoreView(ScoreView* v)
 void Navigator::setScore(Score* v)
       {
       _cv    = 0;
+      if (v != _score) {
+            tiles.clear();
+            pendingTiles.clear();
+            selectedPages.clear();
+            }
       _score = v;
       rescale();
       updateViewRect();
@@ -191,6 +210,7 @@ void Navigator::rescale()
             return;
             }
       Page* lp          = _score->pages().back();
+      QTransform oldMatrix = matrix;
 
       // reset the layout before setting fix size
       setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
@@ -212,6 +232,18 @@ void Navigator::rescale()
             setFixedWidth(int(scoreWidth * m));
             matrix = QTransform(m, 0, 0, m, 0, 0);
             }
+
+      // compute optimal size of page number
+      QFont font("FreeSans", 4000);
+      QFontMetrics fm (font);
+      Page* firstPage = _score->pages()[0];
+      qreal factor = (firstPage->width() * 0.5) / fm.width(QString::number(_score->pages().size()));
+      font.setPointSizeF(font.pointSizeF() * factor);
+
+      if (matrix != oldMatrix || font != pageNumberFont) {
+            pageNumberFont = font;
+            invalidateTiles();
+            }
       }
 
 //---------------------------------------------------------
@@ -312,17 +344,146 @@ void Navigator::setViewRect(const QRectF& _viewRect)
             scrollArea->ensureVisible(viewRect->x(), 0);
       }
 
+//---------------------------------------------------------
+//   TilePainter
+//---------------------------------------------------------
+
+struct TilePainter {
+      QPainter* painter;
+      QRectF rect;                  // page coordinates
+      };
+
 //---------------------------------------------------------
 //   paintElement
 //---------------------------------------------------------
 
 static void paintElement(void* data, Element* e)
       {
-      QPainter* p = static_cast<QPainter*>(data);
+      TilePainter* tp = static_cast<TilePainter*>(data);
       QPointF pos(e->pagePos());
-      p->translate(pos);
-      e->draw(p);
-      p->translate(-pos);
+      QRectF r(e->bbox().translated(pos));
+      if (r.isValid() && !r.intersects(tp->rect))     // the clip takes care of empty boxes
+            return;
+      tp->painter->translate(pos);
+      e->draw(tp->painter);
+      tp->painter->translate(-pos);
+      }
+
+//---------------------------------------------------------
+//   tileCount
+//---------------------------------------------------------
+
+int Navigator::tileCount(const Page* page) const
+      {
+      qreal w = page->abbox().width() * matrix.m11();
+      return qMax(1, qCeil(w / TILE_SIZE));
+      }
+
+//---------------------------------------------------------
+//   tileRect
+//    part of the page covered by a tile, in page
+//    coordinates
+//---------------------------------------------------------
+
+QRectF Navigator::tileRect(const Page* page, int tile) const
+      {
+      QRectF pr(page->abbox());
+      qreal tw = TILE_SIZE / matrix.m11();
+      qreal x  = pr.left() + tile * tw;
+      return QRectF(x, pr.top(), qMin(tw, pr.right() - x), pr.height());
+      }
+
+//---------------------------------------------------------
+//   renderTile
+//    draw a tile of a page at the current navigator scale
+//---------------------------------------------------------
+
+QPixmap Navigator::renderTile(Page* page, int tile) const
+      {
+      qreal dpr = qApp->devicePixelRatio();
+      qreal m   = matrix.m11();
+      QRectF tr(tileRect(page, tile));
+      QPixmap pixmap((tr.size() * m * dpr).toSize());
+      pixmap.setDevicePixelRatio(dpr);
+      pixmap.fill(Qt::white);
+
+      QPainter p(&pixmap);
+      p.scale(m, m);
+      p.translate(-tr.topLeft());
+      p.setClipRect(tr);
+      TilePainter tp { &p, tr };
+      for (System* s  : page->systems()) {
+            for (MeasureBase* mb : s->measures())
+                  mb->scanElements(&tp, paintElement, false);
+            }
+      page->scanElements(&tp, paintElement, false);
+      if (page->score()->layoutMode() == LayoutMode::PAGE) {
+            p.setFont(pageNumberFont);
+            p.setPen(MScore::layoutBreakColor);
+            p.drawText(page->bbox(), Qt::AlignCenter, QString("%1").arg(page->no() + 1 + _score->pageNumberOffset()));
+            }
+      return pixmap;
+      }
+
+//---------------------------------------------------------
+//   invalidateTiles
+//    mark the tiles of page, or of all pages, stale; keep
+//    the pixmaps to paint until they are replaced
+//---------------------------------------------------------
+
+void Navigator::invalidateTiles(const Page* page)
+      {
+      for (const TileKey& key : tiles.keys()) {
+            if (!page || key.first == page)
+                  tiles.object(key)->revision = -1;
+            }
+      }
+
+//---------------------------------------------------------
+//   renderPendingTiles
+//    render one tile per event loop iteration so that
+//    scrolling the navigator stays responsive
+//---------------------------------------------------------
+
+void Navigator::renderPendingTiles()
+      {
+      if (!_score || pendingTiles.isEmpty())
+            return;
+      TileKey key = pendingTiles.takeFirst();
+      Page* page  = const_cast<Page*>(key.first);
+      if (_score->pages().contains(page) && key.second < tileCount(page)) {
+            Tile* t     = new Tile;
+            t->pixmap   = renderTile(page, key.second);
+            t->revision = page->revision();
+            int cost    = qMax(1, t->pixmap.width() * t->pixmap.height() * t->pixmap.depth() / (8 * 1024));
+            tiles.insert(key, t, cost);
+            update();
+            }
+      if (!pendingTiles.isEmpty())
+            renderTimer->start();
+      }
+
+//---------------------------------------------------------
+//   selectionChanged
+//    selected elements are drawn in the selection color,
+//    so pages gaining or losing a selection are stale
+//---------------------------------------------------------
+
+void Navigator::selectionChanged()
+      {
+      if (!_score)
+            return;
+      QSet<const Page*> pages;
+      for (Element* e : _score->selection().elements()) {
+            while (e && !e->isPage())
+                  e = e->parent();
+            if (e)
+                  pages.insert(toPage(e));
+            }
+      for (const Page* page : selectedPages + pages)
+            invalidateTiles(page);
+      selectedPages = pages;
+      update();
       }
 
 //---------------------------------------------------------
@@ -333,6 +494,18 @@ void Navigator::layoutChanged()
       {
       if (_score && !_score->pages().isEmpty())
             rescale();
+
+      // forget tiles of deleted pages and of the part of a page
+      // which is gone
+      if (_score) {
+            QSet<const Page*> pages;
+            for (const Page* page : _score->pages())
+                  pages.insert(page);
+            for (const TileKey& key : tiles.keys()) {
+                  if (!pages.contains(key.first) || key.second >= tileCount(key.first))
+                        tiles.remove(key);
+                  }
+            }
       update();
       }
 
@@ -353,14 +526,6 @@ void Navigator::paintEvent(QPaintEvent* ev)
       if (_score->pages().size() <= 0)
             return;
 
-      // compute optimal size of page number
-      QFont font("FreeSans", 4000);
-      QFontMetrics fm (font);
-      Page* firstPage = _score->pages()[0];
-      qreal factor = (firstPage->width() * 0.5) / fm.width(QString::number(_score->pages().size()));
-      font.setPointSizeF(font.pointSizeF() * factor);
-
-      p.setTransform(matrix);
       QRectF fr = matrix.inverted().mapRect(QRectF(r));
       int i = 0;
       for (Page* page : _score->pages()) {
@@ -373,19 +538,24 @@ void Navigator::paintEvent(QPaintEvent* ev)
             if (pr.left() > fr.right())
                   break;
 
-            p.fillRect(pr, Qt::white);
-            p.translate(pos);
-            for (System* s  : page->systems()) {
-                  for (MeasureBase* m : s->measures())
-                        m->scanElements(&p, paintElement, false);
-                  }
-            page->scanElements(&p, paintElement, false);
-            if (page->score()->layoutMode() == LayoutMode::PAGE) {
-                  p.setFont(font);
-                  p.setPen(MScore::layoutBreakColor);
-                  p.drawText(page->bbox(), Qt::AlignCenter, QString("%1").arg(page->no() + 1 + _score->pageNumberOffset()));
+            // only the tiles in the exposed part of the page
+            qreal tw  = TILE_SIZE / matrix.m11();
+            int n     = tileCount(page);
+            int first = qBound(0, int((fr.left() - pr.left()) / tw), n - 1);
+            int last  = qBound(0, int((fr.right() - pr.left()) / tw), n - 1);
+            for (int tile = first; tile <= last; ++tile) {
+                  QRectF tr(matrix.mapRect(tileRect(page, tile).translated(pos)));
+                  TileKey key(page, tile);
+                  Tile* t = tiles.object(key);
+                  if (!t)
+                        p.fillRect(tr, Qt::white);
+                  else
+                        p.drawPixmap(tr, t->pixmap, QRectF(QPointF(), t->pixmap.size()));
+                  if ((!t || t->revision != page->revision()) && !pendingTiles.contains(key)) {
+                        pendingTiles.append(key);
+                        renderTimer->start();
+                        }
                   }
-            p.translate(-pos);
             i++;
             }
       }
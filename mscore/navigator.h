@@ -73,13 +73,34 @@ class Navigator : public QWidget {
       QTransform matrix;
       bool _previewOnly;
 
+      // a page is rendered in tiles no wider than TILE_SIZE pixels, so
+      // that the single page of continuous view needs neither a pixmap
+      // of unbounded size nor a complete render after every edit
+      struct Tile {
+            QPixmap pixmap;
+            int revision;           // Page::revision() the pixmap was rendered from, -1 if stale
+            };
+      typedef QPair<const Page*, int> TileKey;  // page and tile number
+      QCache<TileKey, Tile> tiles;
+      QList<TileKey> pendingTiles;  // visible tiles which are missing or stale
+      QSet<const Page*> selectedPages;
+      QTimer* renderTimer;
+      QFont pageNumberFont;
+
       void rescale();
+      int tileCount(const Page* page) const;
+      QRectF tileRect(const Page* page, int tile) const;
+      QPixmap renderTile(Page* page, int tile) const;
+      void invalidateTiles(const Page* page = 0);
 
       virtual void paintEvent(QPaintEvent*);
       virtual void mousePressEvent(QMouseEvent*);
       virtual void mouseMoveEvent(QMouseEvent*);
       virtual void resizeEvent(QResizeEvent*);
 
+   private slots:
+      void renderPendingTiles();
+
    public slots:
       void updateViewRect();
       void layoutChanged();
@@ -94,6 +115,7 @@ class Navigator : public QWidget {
       void setPreviewOnly(bool b) { _previewOnly = b; }
       Score* score() const { return _score; }
       void setViewRect(const QRectF& r);
+      void selectionChanged();
       };
 
 
@@ -37,6 +37,7 @@
 #endif
 
 #include "libmscore/page.h"
+#include "libmscore/imageStore.h"
 #include "file.h"
 #include "libmscore/mscore.h"
 #include "shortcut.h"
@@ -311,6 +312,9 @@ void Preferences::write()
       s.setValue("showMidiControls", showMidiControls);
 
       s.setValue("defaultPlayDuration", MScore::defaultPlayDuration);
+      s.setValue("undoMemoryLimit", MScore::undoMemoryLimit);
+      s.setValue("imageCacheLimit", MScore::imageCacheLimit);
+      s.setValue("unusedImageLimit", MScore::unusedImageLimit);
       s.setValue("importStyleFile", importStyleFile);
       s.setValue("shortestNote", shortestNote);
       s.setValue("importCharsetOve", importCharsetOve);
@@ -471,6 +475,11 @@ void Preferences::read()
       showMidiControls       = s.value("showMidiControls", showMidiControls).toBool();
 
       MScore::defaultPlayDuration = s.value("defaultPlayDuration", MScore::defaultPlayDuration).toInt();
+      MScore::undoMemoryLimit = s.value("undoMemoryLimit", MScore::undoMemoryLimit).toInt();
+      MScore::imageCacheLimit = s.value("imageCacheLimit", MScore::imageCacheLimit).toInt();
+      MScore::unusedImageLimit = s.value("unusedImageLimit", MScore::unusedImageLimit).toInt();
+      ImageStore::setCacheLimit(MScore::imageCacheLimit);
+      imageStore.setUnusedLimit(qint64(MScore::unusedImageLimit) * 1024);
       importStyleFile        = s.value("importStyleFile", importStyleFile).toString();
       shortestNote           = s.value("shortestNote", shortestNote).toInt();
       importCharsetOve          = s.value("importCharsetOve", importCharsetOve).toString();
@@ -214,8 +214,10 @@ void ScoreView::setScore(Score* s)
                         _ms->addViewer(this);
                         }
                   }
-            else
+            else {
+                  _score->doPendingLayout();
                   _score->addViewer(this);
+                  }
             }
 
       if (shadowNote == 0) {
@@ -154,6 +154,9 @@ Seq::Seq()
       oggInit  = false;
       _driver  = 0;
       playPos  = events.cbegin();
+      guiPlayPos = events.cbegin();
+      pendingSeek = -1;
+      reportedOverflows = 0;
       playFrame  = 0;
       metronomeVolume = 0.3;
       useJackTransportSavedFlag = false;
@@ -550,10 +553,10 @@ void Seq::recomputeMaxMidiOutPort()
 
 void Seq::processMessages()
       {
-      for (;;) {
-            if (toSeq.empty())
-                  break;
-            SeqMsg msg = toSeq.dequeue();
+      if (pendingSeek >= 0)
+            setPos(pendingSeek);
+      SeqMsg msg;
+      while (toSeq.dequeue(msg)) {
             switch(msg.id) {
                   case SeqMsgId::TEMPO_CHANGE:
                         {
@@ -668,6 +671,8 @@ void Seq::addCountInClicks()
 
 void Seq::process(unsigned framesPerPeriod, float* buffer)
       {
+      AudioProfiler* prof = _synti && _synti->profiler()->enabled() ? _synti->profiler() : nullptr;
+      AudioProfilePeriod period(prof, framesPerPeriod, MScore::sampleRate);
       unsigned framesRemain = framesPerPeriod; // the number of frames remaining to be processed by this call to Seq::process
       Transport driverState = _driver->getState();
       // Checking for the reposition from JACK Transport
@@ -851,10 +856,10 @@ void Seq::process(unsigned framesPerPeriod, float* buffer)
                         tackRemain = tackLength;
                         tackVolume = event.velo() ? qreal(event.value()) / 127.0 : 1.0;
                         }
-                  mutex.lock();
                   ++(*pPlayPos);
-                  mutex.unlock();
                   }
+            if (!inCountIn)
+                  publishPlayPos();
             if (framesRemain) {
                   if (cs->playMode() == PlayMode::SYNTHESIZER) {
                         metronome(framesRemain, p, inCountIn);
@@ -898,8 +903,8 @@ void Seq::process(unsigned framesPerPeriod, float* buffer)
             }
       else {
             // Outside of playback mode
-            while (!liveEventQueue()->empty()) {
-                  const NPlayEvent& event = liveEventQueue()->dequeue();
+            NPlayEvent event;
+            while (liveEventQueue()->dequeue(event)) {
                   if (event.type() == ME_TICK1) {
                         tickRemain = tickLength;
                         tickVolume = event.velo() ? qreal(event.value()) / 127.0 : 1.0;
@@ -998,10 +1003,13 @@ void Seq::collectEvents()
       //do not collect even while playing
       if (state ==  Transport::PLAY)
             return;
-      mutex.lock();
-      events.clear();
+      // render outside of the lock, the real time thread
+      // only has to skip a seek while the playlists are swapped
+      EventMap ev;
+      cs->renderMidi(&ev);
 
-      cs->renderMidi(&events);
+      mutex.lock();
+      events.swap(ev);
       endUTick = 0;
 
       if (!events.empty()) {
@@ -1009,7 +1017,8 @@ void Seq::collectEvents()
             --e;
             endUTick = e->first;
             }
-      playPos  = events.cbegin();
+      playPos    = events.cbegin();
+      guiPlayPos = playPos;
       mutex.unlock();
 
       playlistChanged = false;
@@ -1038,16 +1047,22 @@ void Seq::setRelTempo(double relTempo)
 //   setPos
 //    seek
 //    realtime environment
+//    If the gui thread is swapping the playlist, the seek
+//    is postponed to the next period instead of waiting.
 //---------------------------------------------------------
 
 void Seq::setPos(int utick)
       {
       if (cs == 0)
             return;
+      if (!mutex.tryLock()) {
+            pendingSeek = utick;
+            return;
+            }
+      pendingSeek = -1;
       stopNotes(-1, true);
 
       int ucur;
-      mutex.lock();
       if (playPos != events.end())
             ucur = cs->repeatList()->utick2tick(playPos->first);
       else
@@ -1057,9 +1072,36 @@ void Seq::setPos(int utick)
 
       playFrame = cs->utick2utime(utick) * MScore::sampleRate;
       playPos   = events.lower_bound(utick);
+      guiPlayPos = playPos;
       mutex.unlock();
       }
 
+//---------------------------------------------------------
+//   publishPlayPos
+//    make playPos visible to the gui thread
+//    realtime environment, skipped if the gui thread
+//    holds the lock; the next period publishes again
+//---------------------------------------------------------
+
+void Seq::publishPlayPos()
+      {
+      if (!mutex.tryLock())
+            return;
+      guiPlayPos = playPos;
+      mutex.unlock();
+      }
+
+//---------------------------------------------------------
+//   publishedPlayPos
+//    gui thread
+//---------------------------------------------------------
+
+EventMap::const_iterator Seq::publishedPlayPos() const
+      {
+      QMutexLocker locker(&mutex);
+      return guiPlayPos;
+      }
+
 //---------------------------------------------------------
 //   seekCommon
 //   a common part of seek() and seekRT(), contains code
@@ -1154,7 +1196,8 @@ void Seq::playMetronomeBeat(BeatType type)
       {
       if (state != Transport::STOP)
             return;
-      liveEventQueue()->enqueue(NPlayEvent(type));
+      if (!liveEventQueue()->enqueue(NPlayEvent(type)))
+            qDebug("Seq: live event queue overflow, %d events dropped", liveEventQueue()->overflows());
       }
 
 //---------------------------------------------------------
@@ -1285,7 +1328,8 @@ void Seq::prevMeasure()
 
 void Seq::prevChord()
       {
-      int tick  = playPos->first;
+      EventMap::const_iterator pos = publishedPlayPos();
+      int tick  = pos->first;
       //find the chord just before playpos
       EventMap::const_iterator i = events.upper_bound(cs->repeatList()->tick2utick(tick));
       for (;;) {
@@ -1302,7 +1346,7 @@ void Seq::prevChord()
             }
       //go the previous chord
       if (i != events.cbegin()) {
-            i = playPos;
+            i = pos;
             for (;;) {
                   if (i->second.type() == ME_NOTEON) {
                         const NPlayEvent& n = i->second;
@@ -1335,11 +1379,14 @@ void Seq::guiToSeq(const SeqMsg& msg)
       {
       if (!_driver || !running)
             return;
-      toSeq.enqueue(msg);
+      if (!toSeq.enqueue(msg))
+            qDebug("Seq: message queue overflow, %d messages dropped", toSeq.overflows());
       }
 
 //---------------------------------------------------------
 //   eventToGui
+//    may be called in realtime environment, overflows
+//    are reported by heartBeatTimeout()
 //---------------------------------------------------------
 
 void Seq::eventToGui(NPlayEvent e)
@@ -1357,53 +1404,6 @@ void Seq::midiInputReady()
             _driver->midiRead();
       }
 
-//---------------------------------------------------------
-//   SeqMsgFifo
-//---------------------------------------------------------
-
-SeqMsgFifo::SeqMsgFifo()
-      {
-      maxCount = SEQ_MSG_FIFO_SIZE;
-      clear();
-      }
-
-//---------------------------------------------------------
-//   enqueue
-//---------------------------------------------------------
-
-void SeqMsgFifo::enqueue(const SeqMsg& msg)
-      {
-      int i = 0;
-      int n = 50;
-
-      QMutex mutex;
-      QWaitCondition qwc;
-      mutex.lock();
-      for (; i < n; ++i) {
-            if (!isFull())
-                  break;
-            qwc.wait(&mutex,100);
-            }
-      mutex.unlock();
-      if (i == n) {
-            qDebug("===SeqMsgFifo: overflow");
-            return;
-            }
-      messages[widx] = msg;
-      push();
-      }
-
-//---------------------------------------------------------
-//   dequeue
-//---------------------------------------------------------
-
-SeqMsg SeqMsgFifo::dequeue()
-      {
-      SeqMsg msg = messages[ridx];
-      pop();
-      return msg;
-      }
-
 //---------------------------------------------------------
 //   putEvent
 //---------------------------------------------------------
@@ -1443,8 +1443,8 @@ void Seq::heartBeatTimeout()
             sc->setMeter(meterValue[0], meterValue[1], meterPeakValue[0], meterPeakValue[1]);
             }
 
-      while (!fromSeq.empty()) {
-            SeqMsg msg = fromSeq.dequeue();
+      SeqMsg msg;
+      while (fromSeq.dequeue(msg)) {
             if (msg.id == SeqMsgId::MIDI_INPUT_EVENT) {
                   int type = msg.event.type();
                   if (type == ME_NOTEON)
@@ -1455,17 +1455,19 @@ void Seq::heartBeatTimeout()
                         mscore->midiCtrlReceived(msg.event.controller(), msg.event.value());
                   }
             }
+      if (fromSeq.overflows() != reportedOverflows) {
+            reportedOverflows = fromSeq.overflows();
+            qDebug("Seq: midi input queue overflow, %d events dropped", reportedOverflows);
+            }
 
       if (state != Transport::PLAY || inCountIn)
             return;
 
       int endFrame = playFrame;
 
-      mutex.lock();
-      auto ppos = playPos;
+      auto ppos = publishedPlayPos();
       if (ppos != events.cbegin())
             --ppos;
-      mutex.unlock();
 
       if (cs && cs->sigmap()->timesig(getCurTick()).nominal()!=prevTimeSig) {
             prevTimeSig = cs->sigmap()->timesig(getCurTick()).nominal();
@@ -1551,7 +1553,7 @@ void Seq::updateSynthesizerState(int tick1, int tick2)
 
 double Seq::curTempo() const
       {
-      return cs->tempomap()->tempo(playPos->first);
+      return cs->tempomap()->tempo(publishedPlayPos()->first);
       }
 
 //---------------------------------------------------------
@@ -1562,7 +1564,7 @@ void Seq::setLoopIn()
       {
       int tick;
       if (state == Transport::PLAY) {      // If in playback mode, set the In position where note is being played
-            auto ppos = playPos;
+            auto ppos = publishedPlayPos();
             if (ppos != events.cbegin())
                   --ppos;                 // We have to go back one pos to get the correct note that has just been played
             tick = cs->repeatList()->utick2tick(ppos->first);
@@ -1582,7 +1584,7 @@ void Seq::setLoopOut()
       {
       int tick;
       if (state == Transport::PLAY) {    // If in playback mode, set the Out position where note is being played
-            tick = cs->repeatList()->utick2tick(playPos->first);
+            tick = cs->repeatList()->utick2tick(publishedPlayPos()->first);
             }
       else
             tick = cs->pos() + cs->inputState().ticks();   // Otherwise, use the selected note.
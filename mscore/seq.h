@@ -77,16 +77,10 @@ struct SeqMsg {
 //---------------------------------------------------------
 
 static const int SEQ_MSG_FIFO_SIZE = 1024*8;
+typedef MPSCQueue<SeqMsg, SEQ_MSG_FIFO_SIZE> SeqMsgFifo;
 
-class SeqMsgFifo : public FifoBase {
-      SeqMsg messages[SEQ_MSG_FIFO_SIZE];
-
-   public:
-      SeqMsgFifo();
-      virtual ~SeqMsgFifo()     {}
-      void enqueue(const SeqMsg&);        // put object on fifo
-      SeqMsg dequeue();                   // remove object from fifo
-      };
+static const int LIVE_EVENT_QUEUE_SIZE = 1024;
+typedef MPSCQueue<NPlayEvent, LIVE_EVENT_QUEUE_SIZE> LiveEventQueue;
 
 // this are also the jack audio transport states:
 enum class Transport : char {
@@ -104,7 +98,7 @@ enum class Transport : char {
 class Seq : public QObject, public Sequencer {
       Q_OBJECT
 
-      mutable QMutex mutex;
+      mutable QMutex mutex;               // guards events and guiPlayPos, only try-locked in real time thread
 
       MasterScore* cs;
       ScoreView* cv;
@@ -135,7 +129,7 @@ class Seq : public QObject, public Sequencer {
 
       EventMap events;                    // playlist for playback mode (pre-rendered)
       EventMap countInEvents;             // playlist of any metronome countin clicks
-      QQueue<NPlayEvent> _liveEventQueue; // playlist for score editing and note entry (rendered live)
+      LiveEventQueue _liveEventQueue;     // playlist for score editing and note entry (rendered live)
 
       int playFrame;                      // current play position in samples, relative to the first frame of playback
       int countInPlayFrame;               // current play position in samples, relative to the first frame of countin
@@ -144,6 +138,9 @@ class Seq : public QObject, public Sequencer {
       EventMap::const_iterator playPos;   // moved in real time thread
       EventMap::const_iterator countInPlayPos;
       EventMap::const_iterator guiPos;    // moved in gui thread
+      EventMap::const_iterator guiPlayPos; // playPos as published to the gui thread, guarded by mutex
+      int pendingSeek;                    // seek postponed by the real time thread while the playlist is locked
+      int reportedOverflows;              // fromSeq overflows already reported
 
       QList<const Note*> markedNotes;     // notes marked as sounding
 
@@ -169,7 +166,10 @@ class Seq : public QObject, public Sequencer {
       void updateSynthesizerState(int tick1, int tick2);
       void addCountInClicks();
 
-      inline QQueue<NPlayEvent>* liveEventQueue() { return &_liveEventQueue; }
+      EventMap::const_iterator publishedPlayPos() const;
+      void publishPlayPos();
+
+      inline LiveEventQueue* liveEventQueue() { return &_liveEventQueue; }
 
    private slots:
       void seqMessage(int msg, int arg = 0);
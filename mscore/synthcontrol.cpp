@@ -94,6 +94,13 @@ SynthControl::SynthControl(QWidget* parent)
       connect(storeButton,  SIGNAL(clicked()),                SLOT(storeButtonClicked()));
       connect(recallButton, SIGNAL(clicked()),                SLOT(recallButtonClicked()));
       connect(gain,         SIGNAL(valueChanged(double,int)), SLOT(setDirty()));
+
+      profileText->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+      profileTimer = new QTimer(this);
+      profileTimer->setInterval(500);
+      connect(profileTimer, SIGNAL(timeout()),                SLOT(updateProfile()));
+      connect(profileAudio, SIGNAL(toggled(bool)),            SLOT(profileAudioToggled(bool)));
+      connect(resetProfileButton, SIGNAL(clicked()),          SLOT(resetProfile()));
       }
 
 //---------------------------------------------------------
@@ -406,6 +413,44 @@ void SynthControl::readSettings()
       MuseScore::restoreGeometry(this);
       }
 
+//---------------------------------------------------------
+//   profileAudioToggled
+//---------------------------------------------------------
+
+void SynthControl::profileAudioToggled(bool val)
+      {
+      synti->profiler()->setEnabled(val);
+      resetProfileButton->setEnabled(val);
+      if (val) {
+            synti->profiler()->reset();
+            profileTimer->start();
+            }
+      else
+            profileTimer->stop();
+      updateProfile();
+      }
+
+//---------------------------------------------------------
+//   resetProfile
+//---------------------------------------------------------
+
+void SynthControl::resetProfile()
+      {
+      synti->profiler()->reset();
+      updateProfile();
+      }
+
+//---------------------------------------------------------
+//   updateProfile
+//---------------------------------------------------------
+
+void SynthControl::updateProfile()
+      {
+      if (!isVisible())
+            return;
+      profileText->setPlainText(synti->profiler()->stats().toString());
+      }
+
 //---------------------------------------------------------
 //   changeEvent
 //---------------------------------------------------------
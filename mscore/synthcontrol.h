@@ -37,6 +37,7 @@ class SynthControl : public QWidget, Ui::SynthControl {
 
       Score* _score;
       EnablePlayForWidget* enablePlay;
+      QTimer* profileTimer;
 
       virtual void closeEvent(QCloseEvent*);
       virtual void showEvent(QShowEvent*);
@@ -56,6 +57,9 @@ class SynthControl : public QWidget, Ui::SynthControl {
       void storeButtonClicked();
       void recallButtonClicked();
       void setDirty();
+      void profileAudioToggled(bool);
+      void resetProfile();
+      void updateProfile();
 
    signals:
       void gainChanged(float);
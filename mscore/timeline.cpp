@@ -857,54 +857,127 @@ Timeline::Timeline(TDockWidget* dock_widget, QWidget* parent)
       barlines["Double barline"] = double_barline_pixmap;
       }
 
+//---------------------------------------------------------
+//   TGridItem
+//---------------------------------------------------------
+
+TGridItem::TGridItem(Timeline* t)
+   : timeline(t)
+      {
+      setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+      setAcceptHoverEvents(true);
+      }
+
+//---------------------------------------------------------
+//   boundingRect
+//---------------------------------------------------------
+
+QRectF TGridItem::boundingRect() const
+      {
+      QRectF r = timeline->cellRect(0, 0);
+      r.setWidth(r.width() * timeline->gridColumns());
+      r.setHeight(r.height() * timeline->gridRows());
+      return r.adjusted(-0.5, -0.5, 0.5, 0.5);
+      }
+
+//---------------------------------------------------------
+//   paint
+//    only the cells intersecting the exposed rectangle
+//    are drawn, so the cost does not grow with the score
+//---------------------------------------------------------
+
+void TGridItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
+      {
+      int cols = timeline->gridColumns();
+      int rows = timeline->gridRows();
+      if (cols == 0 || rows == 0)
+            return;
+
+      QRectF origin = timeline->cellRect(0, 0);
+      QRectF exposed = option->exposedRect;
+      int first_col = qMax(0, qFloor((exposed.left() - origin.left()) / origin.width()) - 1);
+      int last_col  = qMin(cols - 1, qFloor((exposed.right() - origin.left()) / origin.width()) + 1);
+      int first_row = qMax(0, qFloor((exposed.top() - origin.top()) / origin.height()) - 1);
+      int last_row  = qMin(rows - 1, qFloor((exposed.bottom() - origin.top()) / origin.height()) + 1);
+
+      painter->setPen(QPen(QColor(204, 204, 204)));
+      for (int col = first_col; col <= last_col; col++) {
+            for (int row = first_row; row <= last_row; row++) {
+                  painter->setBrush(QBrush(timeline->cellColor(col, row)));
+                  painter->drawRect(timeline->cellRect(col, row));
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   hoverMoveEvent
+//---------------------------------------------------------
+
+void TGridItem::hoverMoveEvent(QGraphicsSceneHoverEvent* event)
+      {
+      setToolTip(timeline->cellToolTip(event->pos()));
+      }
+
 //---------------------------------------------------------
 //   drawGrid
+//    The scene is only built again if the columns, rows or
+//    meta rows changed. Otherwise the occupancy of the
+//    measures laid out since the last call is updated and
+//    their meta values are drawn again.
 //---------------------------------------------------------
 
 void Timeline::drawGrid(int global_rows, int global_cols)
       {
+      int first_col = 0;
+      int last_col = -1;
+      bool rebuild = updateOccupancy(global_rows, global_cols, &first_col, &last_col);
+      QStringList layout = gridLayout();
+      if (!grid_item || layout != grid_layout)
+            rebuild = true;
+
+      grid_part_names.clear();
+      for (Part* part : _score->parts()) {
+            QTextDocument doc;
+            doc.setHtml(part->longName());
+            QString part_name = doc.toPlainText();
+            if (part_name.isEmpty())
+                  part_name = part->instrumentName();
+            grid_part_names.push_back(part_name);
+            }
+
+      if (!rebuild) {
+            if (first_col <= last_col) {
+                  removeMetas(first_col, last_col);
+                  drawMetas(first_col, last_col);
+                  }
+            grid_item->update();
+            drawSelection();
+            return;
+            }
+
+      //Items are deleted with the scene
+      std::get<0>(old_hover_info) = nullptr;
+      std::get<1>(old_hover_info) = -1;
       scene()->clear();
+      grid_item = nullptr;
+      selection_item = nullptr;
       meta_rows.clear();
+      grid_layout = layout;
 
       if (global_rows == 0 || global_cols == 0) return;
-      int stagger = 0;
       unsigned int num_metas = nmetas();
       setMinimumHeight(grid_height * (num_metas + 1) + 5 + horizontalScrollBar()->height());
       setMinimumWidth(grid_width * 3);
       global_z_value = 1;
 
-      //Draw grid
-      Measure* curr_measure = _score->firstMeasure();
-      QList<Part*> part_list = _score->parts();
-      for (int col = 0; col < global_cols; col++) {
-            for (int row = 0; row < global_rows; row++) {
-                  QGraphicsRectItem* graphics_rect_item = new QGraphicsRectItem(col * grid_width,
-                                                                                grid_height * (row + num_metas) + 3,
-                                                                                grid_width,
-                                                                                grid_height);
-
-                  setMetaData(graphics_rect_item, row, ElementType::INVALID, curr_measure, false, 0);
-
-                  QString translate_measure = tr("Measure");
-                  QChar initial_letter = translate_measure[0];
-                  QTextDocument doc;
-                  QString part_name = "";
-                  if (part_list.size() > row) {
-                        doc.setHtml(part_list.at(row)->longName());
-                        part_name = doc.toPlainText();
-                        }
-                  if (part_name.isEmpty() && part_list.size() > row)
-                        part_name = part_list.at(row)->instrumentName();
+      //Draw grid, the cells are painted on demand by grid_item
+      grid_top = grid_height * num_metas + 3;
+      grid_selected = QBitArray(grid_occupancy.size());
 
-                  graphics_rect_item->setToolTip(initial_letter + QString(" ") + QString::number(curr_measure->no() + 1) + QString(", ") + part_name);
-                  graphics_rect_item->setPen(QPen(QColor(204, 204, 204)));
-                  graphics_rect_item->setBrush(QBrush(colorBox(graphics_rect_item)));
-                  graphics_rect_item->setZValue(-3);
-                  scene()->addItem(graphics_rect_item);
-                  }
+      grid_item = new TGridItem(this);
+      grid_item->setZValue(-3);
+      scene()->addItem(grid_item);
 
-            curr_measure = curr_measure->nextMeasure();
-            }
       setSceneRect(0, 0, getWidth(), getHeight());
 
       //Draw meta rows and separator
@@ -933,7 +1006,37 @@ void Timeline::drawGrid(int global_rows, int global_cols)
             meta_rows.push_back(pair_graphics_int_meta);
             }
 
-      int x_pos = 0;
+      drawMetas(0, gridColumns() - 1);
+      drawSelection();
+      }
+
+//---------------------------------------------------------
+//   gridLayout
+//    everything besides the score which decides where
+//    drawGrid() puts its items
+//---------------------------------------------------------
+
+QStringList Timeline::gridLayout()
+      {
+      QStringList layout;
+      layout << QString::number(grid_width) << QString::number(grid_height) << QString::number(collapsed_meta);
+      for (auto it = metas.begin(); it != metas.end(); ++it) {
+            if (std::get<2>(*it))
+                  layout << std::get<0>(*it);
+            }
+      return layout;
+      }
+
+//---------------------------------------------------------
+//   drawMetas
+//    add the meta values of the measures in columns
+//    first_col - last_col
+//---------------------------------------------------------
+
+void Timeline::drawMetas(int first_col, int last_col)
+      {
+      int stagger = 0;
+      unsigned int num_metas = nmetas();
 
       //Create stagger array if collapsed_meta is false
       int stagger_arr[num_metas];
@@ -942,8 +1045,11 @@ void Timeline::drawGrid(int global_rows, int global_cols)
 
       bool no_key = true;
       std::get<4>(repeat_info) = false;
+      global_measure_number = -1;
 
-      for (Measure* curr_measure = _score->firstMeasure(); curr_measure; curr_measure = curr_measure->nextMeasure()) {
+      for (int col = first_col; col <= last_col; col++) {
+            Measure* curr_measure = grid_measures[col];
+            int x_pos = col * grid_width;
             for (Segment* curr_seg = curr_measure->first(); curr_seg; curr_seg = curr_seg->next()) {
                   //Toggle no_key if initial key signature is found
                   if (curr_seg->isKeySigType() && curr_measure == _score->firstMeasure()) {
@@ -1000,10 +1106,35 @@ void Timeline::drawGrid(int global_rows, int global_cols)
             for (unsigned int row = 0; row < num_metas; row++) {
                   stagger_arr[row] = 0;
                   }
-            x_pos += grid_width;
             std::get<4>(repeat_info) = false;
             }
-      drawSelection();
+      }
+
+//---------------------------------------------------------
+//   removeMetas
+//    delete the meta values of the measures in columns
+//    first_col - last_col
+//---------------------------------------------------------
+
+void Timeline::removeMetas(int first_col, int last_col)
+      {
+      QSet<Measure*> measures;
+      for (int col = first_col; col <= last_col; col++)
+            measures.insert(grid_measures[col]);
+
+      clearHover();
+      auto it = meta_rows.begin();
+      while (it != meta_rows.end()) {
+            QGraphicsItem* graphics_item = it->first;
+            Measure* measure = static_cast<Measure*>(graphics_item->data(2).value<void*>());
+            if (measure && measures.contains(measure)) {
+                  scene()->removeItem(graphics_item);
+                  delete graphics_item;
+                  it = meta_rows.erase(it);
+                  }
+            else
+                  ++it;
+            }
       }
 
 //---------------------------------------------------------
@@ -1192,7 +1323,7 @@ void Timeline::key_meta(Segment* seg, int* stagger, int pos)
             }
 
       int x = pos + (*stagger) * spacing;
-      Measure* measure = (seg)? seg->measure() : 0;
+      Measure* measure = (seg)? seg->measure() : _score->firstMeasure();
       if (addMetaValue(x, pos, key_text, row, ElementType::KEYSIG, 0, seg, measure, tooltip)) {
             (*stagger)++;
             global_z_value++;
@@ -1347,6 +1478,7 @@ void Timeline::measure_meta(Segment* , int* , int pos)
       //Add measure number
       QString measure_number = (curr_measure->irregular())? "( )" : QString::number(curr_measure->no() + 1);
       QGraphicsTextItem* graphics_text_item = new QGraphicsTextItem(measure_number);
+      graphics_text_item->setData(2, QVariant::fromValue<void*>(curr_measure));
       graphics_text_item->setDefaultTextColor(QColor(0, 0, 0));
       graphics_text_item->setX(pos);
       graphics_text_item->setY(grid_height * row + verticalScrollBar()->value());
@@ -1696,6 +1828,7 @@ void Timeline::changeSelection(SelState)
 
 void Timeline::drawSelection()
       {
+      clearHover();
       selection_path = QPainterPath();
       selection_path.setFillRule(Qt::WindingFill);
 
@@ -1767,6 +1900,21 @@ void Timeline::drawSelection()
                   }
             }
 
+      //Mark the selected cells, grid_item repaints them in blue
+      grid_selected.fill(false);
+      for (const std::tuple<Measure*, int, ElementType>& meta_label : meta_labels_set) {
+            int stave = std::get<1>(meta_label);
+            if (stave == -1 || stave >= grid_rows)
+                  continue;
+            auto it = grid_columns.constFind(std::get<0>(meta_label));
+            if (it == grid_columns.constEnd())
+                  continue;
+            grid_selected.setBit(it.value() * grid_rows + stave);
+            selection_path.addRect(cellRect(it.value(), stave));
+            }
+      if (grid_item)
+            grid_item->update();
+
       QList<QGraphicsItem*> graphics_item_list = scene()->items();
       for (QGraphicsItem* graphics_item : graphics_item_list) {
 
@@ -1774,6 +1922,11 @@ void Timeline::drawSelection()
             ElementType element_type = graphics_item->data(1).value<ElementType>();
             Measure* measure = static_cast<Measure*>(graphics_item->data(2).value<void*>());
 
+            //Meta values kept from the last call may still be highlighted
+            QGraphicsRectItem* meta_rect_item = dynamic_cast<QGraphicsRectItem*>(graphics_item);
+            if (stave == -1 && meta_rect_item && graphics_item->data(5).value<void*>())
+                  meta_rect_item->setBrush(QBrush(Qt::gray));
+
             std::tuple<Measure*, int, ElementType> target_tuple(measure, stave, element_type);
             std::set<std::tuple<Measure*, int, ElementType>>::iterator it;
             it = meta_labels_set.find(target_tuple);
@@ -1810,14 +1963,6 @@ void Timeline::drawSelection()
                               graphics_rect_item->setBrush(QBrush(QColor(173,216,230)));
                         }
                   }
-            //Change color from gray to only blue
-            else if (it != meta_labels_set.end()) {
-                  QGraphicsRectItem* graphics_rect_item = dynamic_cast<QGraphicsRectItem*>(graphics_item);
-                  graphics_rect_item->setBrush(QBrush(QColor(graphics_rect_item->brush().color().red(),
-                                                             graphics_rect_item->brush().color().green(),
-                                                             255)));
-                  selection_path.addRect(graphics_rect_item->rect());
-                  }
             }
 
       QGraphicsPathItem* graphics_path_item = new QGraphicsPathItem(selection_path.simplified());
@@ -1828,12 +1973,12 @@ void Timeline::drawSelection()
 
       graphics_path_item->setBrush(Qt::NoBrush);
       graphics_path_item->setZValue(-1);
-      scene()->addItem(graphics_path_item);
-
-      if (std::get<0>(old_hover_info)) {
-            std::get<0>(old_hover_info) = nullptr;
-            std::get<1>(old_hover_info) = -1;
+      if (selection_item) {
+            scene()->removeItem(selection_item);
+            delete selection_item;
             }
+      scene()->addItem(graphics_path_item);
+      selection_item = graphics_path_item;
       }
 
 //---------------------------------------------------------
@@ -1866,9 +2011,14 @@ void Timeline::mousePressEvent(QMouseEvent* event)
                   max_z_value = graphics_item->zValue();
                   }
             }
-      if (curr_graphics_item) {
-            int stave = curr_graphics_item->data(0).value<int>();
-            Measure* curr_measure = static_cast<Measure*>(curr_graphics_item->data(2).value<void*>());
+      //Cells are not separate items, look them up by position
+      Measure* cell_measure = nullptr;
+      int cell_stave = 0;
+      cellAt(scene_pt, &cell_measure, &cell_stave);
+
+      if (curr_graphics_item || cell_measure) {
+            int stave = curr_graphics_item ? curr_graphics_item->data(0).value<int>() : cell_stave;
+            Measure* curr_measure = curr_graphics_item ? static_cast<Measure*>(curr_graphics_item->data(2).value<void*>()) : cell_measure;
             if (numToStaff(stave) && !numToStaff(stave)->show())
                   return;
 
@@ -1880,36 +2030,22 @@ void Timeline::mousePressEvent(QMouseEvent* event)
                   if (scene_pt.y() > (nmeta - 1) * grid_height + verticalScrollBar()->value() &&
                       scene_pt.y() < bottom_of_meta) {
 
-                        QRectF tmp(scene_pt.x(), 0, 3, nmeta * grid_height + nstaves() * grid_height);
-                        QList<QGraphicsItem*> graphics_item_list = scene()->items(tmp);
-                        Measure* measure = nullptr;
-
-                        for (QGraphicsItem* graphics_item : graphics_item_list) {
-                              measure = static_cast<Measure*>(graphics_item->data(2).value<void*>());
-                              //-3 z value is the grid square values
-                              if (graphics_item->zValue() == -3 && measure)
-                                    break;
-                              }
-                        if (measure)
-                              _cv->adjustCanvasPosition(measure, false);
+                        int col = int(scene_pt.x()) / grid_width;
+                        if (scene_pt.x() >= 0 && col < gridColumns())
+                              _cv->adjustCanvasPosition(grid_measures[col], false);
                         }
                   if (scene_pt.y() < bottom_of_meta)
                         return;
 
-                  QList<QGraphicsItem*> graphics_item_list = items(event->pos());
-                  for (QGraphicsItem* graphics_item : graphics_item_list) {
-                        curr_measure = static_cast<Measure*>(graphics_item->data(2).value<void*>());
-                        stave = graphics_item->data(0).value<int>();
-                        if (curr_measure)
-                              break;
-                        }
+                  curr_measure = cell_measure;
+                  stave = cell_stave;
                   if (!curr_measure) {
                         _score->select(0, SelectType::SINGLE, 0);
                         return;
                         }
                   }
 
-            bool meta_value_clicked = curr_graphics_item->data(3).value<bool>();
+            bool meta_value_clicked = curr_graphics_item && curr_graphics_item->data(3).value<bool>();
 
             scene()->clearSelection();
             if (meta_value_clicked) {
@@ -2079,45 +2215,19 @@ void Timeline::mouseReleaseEvent(QMouseEvent*)
             scene()->removeItem(selection_box);
             _score->deselectAll();
 
-            int width, height;
-            QPoint loc = mapFromScene(selection_box->rect().topLeft());
-            width = int(selection_box->rect().width());
-            height = int(selection_box->rect().height());
-
-            QList<QGraphicsItem*> graphics_item_list = items(QRect(loc.x(), loc.y(), width, height));
-            //Find top left and bottom right to create selection
-            QGraphicsItem* tl_graphics_item = nullptr;
-            QGraphicsItem* br_graphics_item = nullptr;
-            for (QGraphicsItem* graphics_item : graphics_item_list) {
-                  Measure* curr_measure = static_cast<Measure*>(graphics_item->data(2).value<void*>());
-                  if (!curr_measure) continue;
-                  int stave = graphics_item->data(0).value<int>();
-                  if (stave == -1) continue;
-
-                  if (!tl_graphics_item && !br_graphics_item) {
-                        tl_graphics_item = graphics_item;
-                        br_graphics_item = graphics_item;
-                        continue;
-                        }
-
-                  if (graphics_item->boundingRect().top() < tl_graphics_item->boundingRect().top())
-                        tl_graphics_item = graphics_item;
-                  if (graphics_item->boundingRect().left() < tl_graphics_item->boundingRect().left())
-                        tl_graphics_item = graphics_item;
-
-                  if (graphics_item->boundingRect().bottom() > br_graphics_item->boundingRect().bottom())
-                        br_graphics_item = graphics_item;
-                  if (graphics_item->boundingRect().right() > br_graphics_item->boundingRect().right())
-                        br_graphics_item = graphics_item;
-
-                  }
-
-            //Select single tl_graphics_item and then range br_graphics_item
-            if (tl_graphics_item && br_graphics_item) {
-                  Measure* tl_measure = static_cast<Measure*>(tl_graphics_item->data(2).value<void*>());
-                  int tl_stave = tl_graphics_item->data(0).value<int>();
-                  Measure* br_measure = static_cast<Measure*>(br_graphics_item->data(2).value<void*>());
-                  int br_stave = br_graphics_item->data(0).value<int>();
+            //Find top left and bottom right cells to create selection
+            QRectF lasso = selection_box->rect();
+            int tl_col = qMax(0, int(lasso.left() / grid_width));
+            int br_col = qMin(gridColumns() - 1, int(lasso.right() / grid_width));
+            int tl_row = qMax(0, int((lasso.top() - grid_top) / grid_height));
+            int br_row = qMin(grid_rows - 1, int((lasso.bottom() - grid_top) / grid_height));
+
+            //Select single top left cell and then range to bottom right cell
+            if (lasso.right() >= 0 && lasso.bottom() >= grid_top && tl_col <= br_col && tl_row <= br_row) {
+                  Measure* tl_measure = grid_measures[tl_col];
+                  int tl_stave = tl_row;
+                  Measure* br_measure = grid_measures[br_col];
+                  int br_stave = br_row;
                   if (tl_measure && br_measure) {
                         //Focus selection of mmRests here
                         if (tl_measure->mmRest())
@@ -2214,7 +2324,17 @@ void Timeline::updateGrid()
 void Timeline::setScore(Score* s)
       {
       _score = s;
+      std::get<0>(old_hover_info) = nullptr;
+      std::get<1>(old_hover_info) = -1;
       scene()->clear();
+      grid_item = nullptr;
+      selection_item = nullptr;
+      meta_rows.clear();
+      grid_revision = -1;
+      grid_ticks.clear();
+      grid_measures.clear();
+      grid_columns.clear();
+      grid_rows = 0;
 
       if (_score) {
             drawGrid(nstaves(), _score->nmeasures());
@@ -2330,17 +2450,14 @@ void Timeline::updateView()
             //Find respective visible elements in timeline
             QPainterPath visible_painter_path = QPainterPath();
             visible_painter_path.setFillRule(Qt::WindingFill);
-            for (QGraphicsItem* graphics_item : scene()->items()) {
-                  int stave = graphics_item->data(0).value<int>();
-                  Measure* measure = static_cast<Measure*>(graphics_item->data(2).value<void*>());
-                  if (numToStaff(stave) && !numToStaff(stave)->show())
+            for (const std::pair<Measure*, int>& visible_item : visible_items_set) {
+                  int stave = visible_item.second;
+                  if (stave >= grid_rows || (numToStaff(stave) && !numToStaff(stave)->show()))
                         continue;
 
-                  std::pair<Measure*, int> tmp(measure, stave);
-                  std::set<std::pair<Measure*, int>>::iterator it;
-                  it = visible_items_set.find(tmp);
-                  if (it != visible_items_set.end())
-                        visible_painter_path.addRect(graphics_item->boundingRect());
+                  auto it = grid_columns.constFind(visible_item.first);
+                  if (it != grid_columns.constEnd())
+                        visible_painter_path.addRect(cellRect(it.value(), stave));
                   }
 
             QPainterPath non_visible_painter_path = QPainterPath();
@@ -2390,13 +2507,11 @@ int Timeline::nstaves()
       }
 
 //---------------------------------------------------------
-//   colorBox
+//   measureHasChord
 //---------------------------------------------------------
 
-QColor Timeline::colorBox(QGraphicsRectItem* item)
+bool Timeline::measureHasChord(Measure* measure, int stave) const
       {
-      Measure* measure = static_cast<Measure*>(item->data(2).value<void*>());
-      int stave = item->data(0).value<int>();
       for (Segment* seg = measure->first(); seg; seg = seg->next()) {
             if (!seg->isChordRestType())
                   continue;
@@ -2404,11 +2519,135 @@ QColor Timeline::colorBox(QGraphicsRectItem* item)
                   ChordRest* chord_rest = seg->cr(track);
                   if (chord_rest) {
                         if (chord_rest->type() == ElementType::CHORD)
-                              return QColor(Qt::gray);
+                              return true;
                         }
                   }
             }
-      return QColor(211,211,211);
+      return false;
+      }
+
+//---------------------------------------------------------
+//   updateOccupancy
+//    Recompute which cells contain chords. If the measures
+//    and staves are unchanged only the measures laid out
+//    since the last call are scanned again and returned in
+//    first_col - last_col.
+//    Measures are compared by the revision of the measure
+//    list and their ticks, not by address: a deleted measure
+//    leaves its memory to the next one allocated.
+//    Returns true if the grid was built anew.
+//---------------------------------------------------------
+
+bool Timeline::updateOccupancy(int global_rows, int global_cols, int* first_col, int* last_col)
+      {
+      *first_col = 0;
+      *last_col  = -1;
+
+      int start_tick = 0;
+      int end_tick = 0;
+      bool changed = _score->masterScore()->takeChangedRange(&start_tick, &end_tick);
+
+      std::vector<Measure*> measures;
+      std::vector<int> ticks;
+      measures.reserve(global_cols);
+      ticks.reserve(global_cols);
+      for (Measure* m = _score->firstMeasure(); m && int(measures.size()) < global_cols; m = m->nextMeasure()) {
+            measures.push_back(m);
+            ticks.push_back(m->tick());
+            }
+      int revision = _score->measures()->revision();
+
+      if (revision == grid_revision && ticks == grid_ticks && global_rows == grid_rows) {
+            if (!changed)
+                  return false;
+            for (int col = 0; col < gridColumns(); col++) {
+                  Measure* measure = grid_measures[col];
+                  if (measure->endTick() <= start_tick || measure->tick() > end_tick)
+                        continue;
+                  if (*first_col > *last_col)
+                        *first_col = col;
+                  *last_col = col;
+                  for (int row = 0; row < grid_rows; row++)
+                        grid_occupancy.setBit(col * grid_rows + row, measureHasChord(measure, row));
+                  }
+            return false;
+            }
+
+      grid_revision = revision;
+      grid_ticks.swap(ticks);
+      grid_measures.swap(measures);
+      grid_rows = global_rows;
+      grid_columns.clear();
+      grid_occupancy = QBitArray(gridColumns() * grid_rows);
+      for (int col = 0; col < gridColumns(); col++) {
+            Measure* measure = grid_measures[col];
+            grid_columns.insert(measure, col);
+            for (int row = 0; row < grid_rows; row++)
+                  grid_occupancy.setBit(col * grid_rows + row, measureHasChord(measure, row));
+            }
+      *last_col = gridColumns() - 1;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   cellColor
+//---------------------------------------------------------
+
+QColor Timeline::cellColor(int col, int row) const
+      {
+      int idx = col * grid_rows + row;
+      QColor color = grid_occupancy.testBit(idx) ? QColor(Qt::gray) : QColor(211,211,211);
+      //Change color from gray to only blue
+      if (grid_selected.testBit(idx))
+            color.setBlue(255);
+      return color;
+      }
+
+//---------------------------------------------------------
+//   cellRect
+//---------------------------------------------------------
+
+QRectF Timeline::cellRect(int col, int row) const
+      {
+      return QRectF(col * grid_width, grid_top + row * grid_height, grid_width, grid_height);
+      }
+
+//---------------------------------------------------------
+//   cellAt
+//    find the measure and staff of the cell at scene
+//    position p, return false if there is none
+//---------------------------------------------------------
+
+bool Timeline::cellAt(const QPointF& p, Measure** measure, int* stave) const
+      {
+      if (p.x() < 0 || p.y() < grid_top)
+            return false;
+      int col = int(p.x() / grid_width);
+      int row = int((p.y() - grid_top) / grid_height);
+      if (col >= gridColumns() || row >= grid_rows)
+            return false;
+      *measure = grid_measures[col];
+      *stave = row;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   cellToolTip
+//---------------------------------------------------------
+
+QString Timeline::cellToolTip(const QPointF& p) const
+      {
+      Measure* measure;
+      int stave;
+      if (!cellAt(p, &measure, &stave))
+            return QString();
+
+      QString translate_measure = tr("Measure");
+      QChar initial_letter = translate_measure[0];
+      QString part_name = "";
+      if (int(grid_part_names.size()) > stave)
+            part_name = grid_part_names[stave];
+      return initial_letter + QString(" ") + QString::number(measure->no() + 1) + QString(", ") + part_name;
       }
 
 //---------------------------------------------------------
@@ -2493,6 +2732,29 @@ void Timeline::handle_scroll(int value)
       viewport()->update();
       }
 
+//---------------------------------------------------------
+//   clearHover
+//    give the hovered meta value its z value and color back
+//---------------------------------------------------------
+
+void Timeline::clearHover()
+      {
+      QGraphicsItem* hovered_item = std::get<0>(old_hover_info);
+      if (!hovered_item)
+            return;
+      QGraphicsItem* pair_item = static_cast<QGraphicsItem*>(hovered_item->data(5).value<void*>());
+      hovered_item->setZValue(std::get<1>(old_hover_info));
+      pair_item->setZValue(std::get<1>(old_hover_info));
+      QGraphicsRectItem* graphics_rect_item1 = dynamic_cast<QGraphicsRectItem*>(hovered_item);
+      QGraphicsRectItem* graphics_rect_item2 = dynamic_cast<QGraphicsRectItem*>(pair_item);
+      if (graphics_rect_item1)
+            graphics_rect_item1->setBrush(QBrush(std::get<2>(old_hover_info)));
+      if (graphics_rect_item2)
+            graphics_rect_item2->setBrush(QBrush(std::get<2>(old_hover_info)));
+      std::get<0>(old_hover_info) = nullptr;
+      std::get<1>(old_hover_info) = -1;
+      }
+
 //---------------------------------------------------------
 //   mouseOver
 //---------------------------------------------------------
@@ -2517,53 +2779,19 @@ void Timeline::mouseOver(QPointF pos)
             }
 
       if (!hovered_graphics_item) {
-            if (std::get<0>(old_hover_info)) {
-                  std::get<0>(old_hover_info)->setZValue(std::get<1>(old_hover_info));
-                  static_cast<QGraphicsItem*>(std::get<0>(old_hover_info)->data(5).value<void*>())->setZValue(std::get<1>(old_hover_info));
-                  QGraphicsRectItem* graphics_rect_item1 = dynamic_cast<QGraphicsRectItem*>(std::get<0>(old_hover_info));
-                  QGraphicsRectItem* graphics_rect_item2 = dynamic_cast<QGraphicsRectItem*>(static_cast<QGraphicsItem*>(std::get<0>(old_hover_info)->data(5).value<void*>()));
-                  if (graphics_rect_item1)
-                        graphics_rect_item1->setBrush(QBrush(std::get<2>(old_hover_info)));
-                  if (graphics_rect_item2)
-                        graphics_rect_item2->setBrush(QBrush(std::get<2>(old_hover_info)));
-                  std::get<0>(old_hover_info) = nullptr;
-                  std::get<1>(old_hover_info) = -1;
-                  }
+            clearHover();
             return;
             }
       QGraphicsItem* pair_item = static_cast<QGraphicsItem*>(hovered_graphics_item->data(5).value<void*>());
       if (!pair_item) {
-            if (std::get<0>(old_hover_info)) {
-                  std::get<0>(old_hover_info)->setZValue(std::get<1>(old_hover_info));
-                  static_cast<QGraphicsItem*>(std::get<0>(old_hover_info)->data(5).value<void*>())->setZValue(std::get<1>(old_hover_info));
-                  QGraphicsRectItem* graphics_rect_item1 = dynamic_cast<QGraphicsRectItem*>(std::get<0>(old_hover_info));
-                  QGraphicsRectItem* graphics_rect_item2 = dynamic_cast<QGraphicsRectItem*>(static_cast<QGraphicsItem*>(std::get<0>(old_hover_info)->data(5).value<void*>()));
-                  if (graphics_rect_item1)
-                        graphics_rect_item1->setBrush(QBrush(std::get<2>(old_hover_info)));
-                  if (graphics_rect_item2)
-                        graphics_rect_item2->setBrush(QBrush(std::get<2>(old_hover_info)));
-                  std::get<0>(old_hover_info) = nullptr;
-                  std::get<1>(old_hover_info) = -1;
-                  }
+            clearHover();
             return;
             }
 
       if (std::get<0>(old_hover_info) == hovered_graphics_item)
             return;
 
-      if (std::get<0>(old_hover_info)) {
-            std::get<0>(old_hover_info)->setZValue(std::get<1>(old_hover_info));
-            static_cast<QGraphicsItem*>(std::get<0>(old_hover_info)->data(5).value<void*>())->setZValue(std::get<1>(old_hover_info));
-            QGraphicsRectItem* graphics_rect_item1 = dynamic_cast<QGraphicsRectItem*>(std::get<0>(old_hover_info));
-            QGraphicsRectItem* graphics_rect_item2 = dynamic_cast<QGraphicsRectItem*>(static_cast<QGraphicsItem*>(std::get<0>(old_hover_info)->data(5).value<void*>()));
-            if (graphics_rect_item1)
-                  graphics_rect_item1->setBrush(QBrush(std::get<2>(old_hover_info)));
-            if (graphics_rect_item2)
-                  graphics_rect_item2->setBrush(QBrush(std::get<2>(old_hover_info)));
-
-            std::get<0>(old_hover_info) = nullptr;
-            std::get<1>(old_hover_info) = -1;
-            }
+      clearHover();
 
       std::get<1>(old_hover_info) = hovered_graphics_item->zValue();
       std::get<0>(old_hover_info) = hovered_graphics_item;
@@ -2770,13 +2998,10 @@ QString Timeline::cursorIsOn()
             if (it != meta_rows.end())
                   return "meta";
             else {
-                  QList<QGraphicsItem*> graphics_item_list = scene()->items(scene_pos);
-                  for (QGraphicsItem* curr_graphics_item : graphics_item_list) {
-                        Measure* curr_measure = static_cast<Measure*>(curr_graphics_item->data(2).value<void*>());
-                        int stave = curr_graphics_item->data(0).value<int>();
-                        if (curr_measure && !numToStaff(stave)->show())
-                              return "invalid";
-                        }
+                  Measure* curr_measure;
+                  int stave;
+                  if (cellAt(scene_pos, &curr_measure, &stave) && !numToStaff(stave)->show())
+                        return "invalid";
                   return "instrument";
                   }
             }
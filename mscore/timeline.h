@@ -109,6 +109,24 @@ class TRowLabels : public QGraphicsView {
       QString cursorIsOn();
       };
 
+//---------------------------------------------------------
+//   TGridItem
+//    paints the measure x staff cells of the timeline,
+//    but only those inside the exposed rectangle
+//---------------------------------------------------------
+
+class TGridItem : public QGraphicsItem {
+      Timeline* timeline;
+
+   protected:
+      virtual void hoverMoveEvent(QGraphicsSceneHoverEvent* event) override;
+
+   public:
+      TGridItem(Timeline* t);
+      virtual QRectF boundingRect() const override;
+      virtual void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) override;
+      };
+
 //---------------------------------------------------------
 //   Timeline
 //---------------------------------------------------------
@@ -135,6 +153,21 @@ class Timeline : public QGraphicsView {
       ScoreView* _cv = nullptr;
 
       QGraphicsRectItem* selection_box;
+
+      //Cell state, one bit per measure and staff at col * grid_rows + row
+      TGridItem* grid_item = nullptr;
+      std::vector<Measure*> grid_measures;
+      std::vector<int> grid_ticks;              // tick of every column
+      int grid_revision = -1;                   // revision of the measure list the grid was built for
+      QStringList grid_layout;                  // gridLayout() the scene was built for
+      QGraphicsPathItem* selection_item = nullptr;
+      QHash<Measure*, int> grid_columns;
+      int grid_rows = 0;
+      int grid_top = 0;
+      QBitArray grid_occupancy;
+      QBitArray grid_selected;
+      std::vector<QString> grid_part_names;
+
       std::vector<std::pair<QGraphicsItem*, int>> meta_rows;
 
       QPainterPath selection_path;
@@ -157,6 +190,13 @@ class Timeline : public QGraphicsView {
       void setMetaData(QGraphicsItem* gi, int staff, ElementType et, Measure* m, bool full_measure, Element* e, QGraphicsItem* pair_item = nullptr, Segment* seg = nullptr);
       unsigned int getMetaRow(QString target_text);
 
+      bool updateOccupancy(int global_rows, int global_cols, int* first_col, int* last_col);
+      QStringList gridLayout();
+      void drawMetas(int first_col, int last_col);
+      void removeMetas(int first_col, int last_col);
+      void clearHover();
+      bool measureHasChord(Measure* measure, int stave) const;
+
       int global_measure_number;
       int global_z_value = 0;
 
@@ -205,7 +245,13 @@ class Timeline : public QGraphicsView {
 
       void updateGrid();
 
-      QColor colorBox(QGraphicsRectItem* item);
+      QColor cellColor(int col, int row) const;
+      QRectF cellRect(int col, int row) const;
+      int gridColumns() const { return int(grid_measures.size()); }
+      int gridRows() const { return grid_rows; }
+      int gridTop() const { return grid_top; }
+      bool cellAt(const QPointF& p, Measure** measure, int* stave) const;
+      QString cellToolTip(const QPointF& p) const;
 
       std::vector<std::pair<QString, bool>> getLabels();
 
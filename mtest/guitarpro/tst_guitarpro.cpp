@@ -145,6 +145,7 @@ private slots:
       void gpxOttava5()      { gpReadTest("ottava5", "gpx"); }
       void gpxChornamesKeyboard() { gpReadTest("chordnames_keyboard", "gpx"); }
       void gpxClefs() { gpReadTest("clefs", "gpx"); }
+      void gpxImportBenchmark();
       };
 
 //---------------------------------------------------------
@@ -171,5 +172,23 @@ void TestGuitarPro::gpReadTest(const char* file, const char* ext)
       delete score;
       }
 
+//---------------------------------------------------------
+//   gpxImportBenchmark
+//    import every Guitar Pro 6 file of the test corpus
+//---------------------------------------------------------
+
+void TestGuitarPro::gpxImportBenchmark()
+      {
+      QStringList files = QDir(root + "/" + DIR).entryList(QStringList("*.gpx"), QDir::Files, QDir::Name);
+      QVERIFY(!files.isEmpty());
+      QBENCHMARK {
+            for (const QString& file : files) {
+                  MasterScore* score = readScore(DIR + file);
+                  QVERIFY(score);
+                  delete score;
+                  }
+            }
+      }
+
 QTEST_MAIN(TestGuitarPro)
 #include "tst_guitarpro.moc"
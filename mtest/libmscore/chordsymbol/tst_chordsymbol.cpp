@@ -23,6 +23,8 @@
 #include "libmscore/harmony.h"
 #include "libmscore/duration.h"
 #include "libmscore/durationtype.h"
+#include "libmscore/chordlist.h"
+#include "libmscore/xml.h"
 
 #define DIR QString("libmscore/chordsymbol/")
 
@@ -37,6 +39,7 @@ class TestChordSymbol : public QObject, public MTest {
 
       MasterScore* test_pre(const char* p);
       void test_post(MasterScore* score, const char* p);
+      QByteArray chordListXml(const ChordList& cl);
 
    private slots:
       void initTestCase();
@@ -47,6 +50,8 @@ class TestChordSymbol : public QObject, public MTest {
       void testNoSystem();
       void testTranspose();
       void testTransposePart();
+      void testChordListCache();
+      void testParseCache();
       };
 
 //---------------------------------------------------------
@@ -195,5 +200,76 @@ void TestChordSymbol::testTransposePart()
       test_post(score, "transpose-part");
       }
 
+//---------------------------------------------------------
+//   chordListXml
+//---------------------------------------------------------
+
+QByteArray TestChordSymbol::chordListXml(const ChordList& cl)
+      {
+      QBuffer buffer;
+      buffer.open(QIODevice::WriteOnly);
+      XmlWriter xml(0, &buffer);
+      cl.write(xml);
+      return buffer.data();
+      }
+
+//---------------------------------------------------------
+//   testChordListCache
+//    a description file read again comes from the shared
+//    cache and equals the parsed one
+//---------------------------------------------------------
+
+void TestChordSymbol::testChordListCache()
+      {
+      QString styles = root + "/../share/styles/";
+      ChordList cl1;
+      QVERIFY(cl1.read(styles + "chords.xml"));
+      QVERIFY(cl1.read(styles + "chords_jazz.xml"));
+      ChordList cl2;
+      QVERIFY(cl2.read(styles + "chords.xml"));
+      QVERIFY(cl2.read(styles + "chords_jazz.xml"));
+      QCOMPARE(chordListXml(cl2), chordListXml(cl1));
+
+      // a different file on top of chords.xml is not taken from the cache
+      ChordList cl3;
+      QVERIFY(cl3.read(styles + "chords.xml"));
+      QVERIFY(cl3.read(styles + "chords_std.xml"));
+      QVERIFY(chordListXml(cl3) != chordListXml(cl1));
+
+      // neither is a file read on top of a modified list
+      ChordDescription cd("Xtest");
+      cl1.insert(cd.id, cd);
+      QVERIFY(cl1.read(styles + "chords_jazz.xml"));
+      QVERIFY(cl1.contains(cd.id));
+      }
+
+//---------------------------------------------------------
+//   testParseCache
+//    parsing the same string twice gives the same chord
+//---------------------------------------------------------
+
+void TestChordSymbol::testParseCache()
+      {
+      ChordList cl;
+      QVERIFY(cl.read(root + "/../share/styles/chords.xml"));
+      QVERIFY(cl.read(root + "/../share/styles/chords_std.xml"));
+      for (const QString& s : { "m7b5", "maj9#11", "7(b9)", "sus4" }) {
+            ParsedChord pc1;
+            ParsedChord pc2;
+            pc1.parse(s, &cl);
+            pc2.parse(s, &cl);
+            QCOMPARE(pc2.handle(), pc1.handle());
+            QCOMPARE(pc2.xmlKind(), pc1.xmlKind());
+            QCOMPARE(pc2.xmlDegrees(), pc1.xmlDegrees());
+            QCOMPARE(pc2.keys(), pc1.keys());
+            QCOMPARE(pc2.renderList(&cl).size(), pc1.renderList(&cl).size());
+            }
+      ParsedChord minor;
+      minor.parse("7b5", &cl, false, true);
+      ParsedChord plain;
+      plain.parse("7b5", &cl, false, false);
+      QVERIFY(minor.name() != plain.name());
+      }
+
 QTEST_MAIN(TestChordSymbol)
 #include "tst_chordsymbol.moc"
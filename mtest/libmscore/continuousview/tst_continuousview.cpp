@@ -0,0 +1,188 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/lyrics.h"
+#include "libmscore/system.h"
+#include "libmscore/layout.h"
+#include "mtest/testutils.h"
+
+#define DIR QString("libmscore/continuousview/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestContinuousView
+//---------------------------------------------------------
+
+class TestContinuousView : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      MasterScore* readLinear(VerticalAlignRange alignRange);
+      Note* note(MasterScore* score, int measureIdx, int chordIdx) const;
+      void changePitch(MasterScore* score, int measureIdx, int chordIdx, int pitch, int tpc);
+      QStringList layoutPositions(MasterScore* score) const;
+
+   private slots:
+      void initTestCase();
+      void incrementalLayout_data();
+      void incrementalLayout();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestContinuousView::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   readLinear
+//    read the reference score and lay it out in
+//    continuous view
+//---------------------------------------------------------
+
+MasterScore* TestContinuousView::readLinear(VerticalAlignRange alignRange)
+      {
+      MasterScore* score = readScore(DIR + "continuousview.mscx");
+      score->style().set(StyleIdx::autoplaceVerticalAlignRange, int(alignRange));
+      score->setLayoutMode(LayoutMode::LINE);
+      score->doLayout();
+      return score;
+      }
+
+//---------------------------------------------------------
+//   note
+//---------------------------------------------------------
+
+Note* TestContinuousView::note(MasterScore* score, int measureIdx, int chordIdx) const
+      {
+      Measure* m = score->firstMeasure();
+      for (int i = 0; i < measureIdx; ++i)
+            m = m->nextMeasure();
+      Segment* s = m->first(SegmentType::ChordRest);
+      for (int i = 0; i < chordIdx; ++i)
+            s = s->next(SegmentType::ChordRest);
+      return toChord(s->element(0))->upNote();
+      }
+
+//---------------------------------------------------------
+//   changePitch
+//---------------------------------------------------------
+
+void TestContinuousView::changePitch(MasterScore* score, int measureIdx, int chordIdx, int pitch, int tpc)
+      {
+      score->startCmd();
+      score->undoChangePitch(note(score, measureIdx, chordIdx), pitch, tpc, tpc);
+      score->endCmd();
+      }
+
+//---------------------------------------------------------
+//   layoutPositions
+//    width and staff distances of the system, position
+//    and width of every measure and segment, position of
+//    notes and lyrics
+//---------------------------------------------------------
+
+QStringList TestContinuousView::layoutPositions(MasterScore* score) const
+      {
+      QStringList l;
+      System* system = score->systems().front();
+      l.append(QString("systems %1 width %2").arg(score->systems().size()).arg(system->width()));
+      for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx)
+            l.append(QString("staff %1 y %2").arg(staffIdx).arg(system->staff(staffIdx)->y()));
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            l.append(QString("measure %1 x %2 w %3").arg(m->no()).arg(m->pos().x()).arg(m->width()));
+            for (Segment* s = m->first(); s; s = s->next()) {
+                  l.append(QString("   segment %1 x %2 w %3").arg(s->tick()).arg(s->pos().x()).arg(s->width()));
+                  Element* e = s->element(0);
+                  if (!e || !e->isChord())
+                        continue;
+                  Chord* c = toChord(e);
+                  for (Note* n : c->notes())
+                        l.append(QString("      note %1 %2").arg(n->pagePos().x()).arg(n->pagePos().y()));
+                  for (Lyrics* ly : c->lyrics())
+                        l.append(QString("      lyrics %1 %2").arg(ly->pagePos().x()).arg(ly->pagePos().y()));
+                  }
+            }
+      return l;
+      }
+
+//---------------------------------------------------------
+//   incrementalLayout
+//    after an edit in continuous view only a window of
+//    measures is laid out again, the result must be the
+//    same as a full layout of the edited score
+//    With lyrics aligned over the whole system the edits
+//    take the full layout fallback.
+//---------------------------------------------------------
+
+void TestContinuousView::incrementalLayout_data()
+      {
+      QTest::addColumn<int>("alignRange");
+      QTest::addColumn<int>("measure");
+      QTest::addColumn<int>("chord");
+      QTest::addColumn<int>("pitch");
+      QTest::addColumn<int>("tpc");
+
+      const int measureAlign = int(VerticalAlignRange::MEASURE);
+      const int systemAlign  = int(VerticalAlignRange::SYSTEM);
+
+      QTest::newRow("sameWidth")            << measureAlign << 5  << 1 << 76 << 18;    // E5
+      QTest::newRow("accidental")           << measureAlign << 5  << 2 << 78 << 20;    // F#5, the measure gets wider
+      QTest::newRow("firstMeasure")         << measureAlign << 0  << 0 << 78 << 20;
+      QTest::newRow("lastMeasure")          << measureAlign << 11 << 3 << 78 << 20;
+      QTest::newRow("lyricsMoveDown")       << measureAlign << 7  << 2 << 55 << 15;    // G3, lyrics of the measure move down
+      QTest::newRow("systemAccidental")     << systemAlign  << 5  << 2 << 78 << 20;
+      QTest::newRow("systemLyricsMoveDown") << systemAlign  << 7  << 2 << 55 << 15;    // lyrics of the whole system move down
+      }
+
+void TestContinuousView::incrementalLayout()
+      {
+      QFETCH(int, alignRange);
+      QFETCH(int, measure);
+      QFETCH(int, chord);
+      QFETCH(int, pitch);
+      QFETCH(int, tpc);
+
+      MasterScore* incremental = readLinear(VerticalAlignRange(alignRange));
+      MasterScore* full        = readLinear(VerticalAlignRange(alignRange));
+      QCOMPARE(layoutPositions(incremental), layoutPositions(full));
+
+      changePitch(incremental, measure, chord, pitch, tpc);
+      changePitch(full, measure, chord, pitch, tpc);
+      full->doLayout();
+      QCOMPARE(note(incremental, measure, chord)->pitch(), pitch);
+      QCOMPARE(layoutPositions(incremental), layoutPositions(full));
+
+      // undo is laid out incrementally as well
+      incremental->undoRedo(true, 0);
+      full->undoRedo(true, 0);
+      full->doLayout();
+      QCOMPARE(layoutPositions(incremental), layoutPositions(full));
+
+      delete incremental;
+      delete full;
+      }
+
+QTEST_MAIN(TestContinuousView)
+#include "tst_continuousview.moc"
+
@@ -15,6 +15,8 @@
 
 #include "libmscore/cursor.h"
 #include "libmscore/score.h"
+#include "libmscore/dynamic.h"
+#include "libmscore/segment.h"
 
 using namespace Ms;
 
@@ -29,6 +31,7 @@ class TestCursor : public QObject, public MTest
    private slots:
       void initTestCase();
       void testAddNoteTickUpdate();
+      void testNoteData();
       };
 
 //---------------------------------------------------------
@@ -72,6 +75,61 @@ void TestCursor::testAddNoteTickUpdate()
       QCOMPARE(c.tick(), MScore::division * 2); //one division == 1 crotchet
       }
 
+//---------------------------------------------------------
+///   testNoteData
+///   Read notes in bulk and change a property of several notes in one command
+//---------------------------------------------------------
+
+void TestCursor::testNoteData()
+      {
+      score = new Score();
+      score->appendPart("voice");
+      score->appendMeasures(2);
+      Cursor c(score);
+      c.rewind(0);
+      c.setDuration(1, 8);
+      for (int pitch : { 60, 62, 64, 65 })
+            c.addNote(pitch);
+
+      int eighth = MScore::division / 2;
+      QVariantMap data = c.noteData(0, 1, 0, -1);
+      QCOMPARE(data["pitch"].value<QList<int>>(), QList<int>({ 60, 62, 64, 65 }));
+      QCOMPARE(data["tick"].value<QList<int>>(), QList<int>({ 0, eighth, 2 * eighth, 3 * eighth }));
+      QCOMPARE(data["duration"].value<QList<int>>(), QList<int>({ eighth, eighth, eighth, eighth }));
+      QCOMPARE(data["velocity"].value<QList<int>>().size(), 4);
+
+      // range restricted to the second and third note
+      data = c.noteData(0, 1, eighth, 3 * eighth);
+      QCOMPARE(data["pitch"].value<QList<int>>(), QList<int>({ 62, 64 }));
+
+      QVariantList offsets({ 10, QVariant(), -10, 0 });
+      QCOMPARE(c.applyNoteProperty(0, 1, 0, -1, "velo_offset", offsets), 2);
+      QList<int> velocities = c.noteData(0, 1, 0, -1)["velocity"].value<QList<int>>();
+      QVERIFY(velocities[0] > velocities[1]);
+      QVERIFY(velocities[2] < velocities[1]);
+
+      // both changes are undone together
+      score->undoStack()->undo(0);
+      QList<int> restored = c.noteData(0, 1, 0, -1)["velocity"].value<QList<int>>();
+      QCOMPARE(restored[0], velocities[1]);
+      QCOMPARE(restored[2], velocities[1]);
+
+      // velocities follow a new dynamic before the score is laid out again
+      score->startCmd();
+      Dynamic* d = new Dynamic(score);
+      d->setDynamicType("pp");
+      d->setTrack(0);
+      d->setParent(score->tick2segment(0, false, SegmentType::ChordRest));
+      score->undoAddElement(d);
+      QList<int> soft = c.noteData(0, 1, 0, -1)["velocity"].value<QList<int>>();
+      QVERIFY(soft[0] < restored[0]);
+      score->endCmd();
+
+      // a cursor without score changes nothing
+      Cursor nc;
+      QCOMPARE(nc.applyNoteProperty(0, 1, 0, -1, "velo_offset", offsets), 0);
+      }
+
 QTEST_MAIN(TestCursor)
 #include "tst_cursor.moc"
 
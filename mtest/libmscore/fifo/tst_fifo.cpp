@@ -0,0 +1,229 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/fifo.h"
+
+using namespace Ms;
+
+static const int QUEUE_SIZE = 1024;
+static const int PRODUCERS  = 4;
+
+//---------------------------------------------------------
+//   Item
+//---------------------------------------------------------
+
+struct Item {
+      int producer { -1 };
+      int seq      { -1 };
+      };
+
+typedef MPSCQueue<Item, QUEUE_SIZE> Queue;
+
+//---------------------------------------------------------
+//   Producer
+//    enqueue n items numbered from 0, if retry is set a
+//    failed enqueue is repeated until it succeeds
+//---------------------------------------------------------
+
+class Producer : public QThread {
+      Queue* _queue;
+      int _id;
+      int _n;
+      bool _retry;
+
+   public:
+      int failed { 0 };
+
+      Producer(Queue* q, int id, int n, bool retry) : _queue(q), _id(id), _n(n), _retry(retry) {}
+      virtual void run() {
+            for (int i = 0; i < _n; ++i) {
+                  Item item;
+                  item.producer = _id;
+                  item.seq      = i;
+                  while (!_queue->enqueue(item)) {
+                        if (!_retry) {
+                              ++failed;
+                              break;
+                              }
+                        yieldCurrentThread();
+                        }
+                  }
+            }
+      };
+
+//---------------------------------------------------------
+//   TestFifo
+//---------------------------------------------------------
+
+class TestFifo : public QObject
+      {
+      Q_OBJECT
+
+      bool drain(Queue* q, QVector<int>* next, int* count);
+
+   private slots:
+      void belowCapacity();
+      void concurrentConsumer();
+      void overflow();
+      };
+
+//---------------------------------------------------------
+//   drain
+//    dequeue everything, check that the items of each
+//    producer arrive in order without gaps or duplicates
+//---------------------------------------------------------
+
+bool TestFifo::drain(Queue* q, QVector<int>* next, int* count)
+      {
+      Item item;
+      while (q->dequeue(item)) {
+            if (item.producer < 0 || item.producer >= next->size()) {
+                  qDebug("bad producer %d", item.producer);
+                  return false;
+                  }
+            int& expected = (*next)[item.producer];
+            if (item.seq != expected) {
+                  qDebug("producer %d: got item %d, expected %d", item.producer, item.seq, expected);
+                  return false;
+                  }
+            ++expected;
+            ++*count;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   belowCapacity
+//    producers fill the queue up to its capacity while
+//    nobody reads, nothing may be dropped
+//---------------------------------------------------------
+
+void TestFifo::belowCapacity()
+      {
+      QScopedPointer<Queue> q(new Queue);
+      QVERIFY(q->empty());
+      const int n = QUEUE_SIZE / PRODUCERS;
+      QList<Producer*> producers;
+      for (int i = 0; i < PRODUCERS; ++i)
+            producers.append(new Producer(q.data(), i, n, false));
+      for (Producer* p : producers)
+            p->start();
+      int failed = 0;
+      for (Producer* p : producers) {
+            p->wait();
+            failed += p->failed;
+            }
+      qDeleteAll(producers);
+      QCOMPARE(failed, 0);
+      QCOMPARE(q->overflows(), 0);
+
+      QVector<int> next(PRODUCERS, 0);
+      int count = 0;
+      QVERIFY(drain(q.data(), &next, &count));
+      QCOMPARE(count, PRODUCERS * n);
+      for (int i = 0; i < PRODUCERS; ++i)
+            QCOMPARE(next[i], n);
+      QVERIFY(q->empty());
+      }
+
+//---------------------------------------------------------
+//   concurrentConsumer
+//    producers write many times the capacity while the
+//    consumer reads, retrying when the queue is full
+//---------------------------------------------------------
+
+void TestFifo::concurrentConsumer()
+      {
+      QScopedPointer<Queue> q(new Queue);
+      const int n = QUEUE_SIZE * 20;
+      QList<Producer*> producers;
+      for (int i = 0; i < PRODUCERS; ++i)
+            producers.append(new Producer(q.data(), i, n, true));
+      for (Producer* p : producers)
+            p->start();
+
+      // keep reading after a failure: the producers wait for
+      // free slots and must finish before the test returns
+      QVector<int> next(PRODUCERS, 0);
+      int count = 0;
+      bool ok = true;
+      bool running = true;
+      while (running) {
+            running = false;
+            for (Producer* p : producers)
+                  running = running || !p->isFinished();
+            if (!drain(q.data(), &next, &count))
+                  ok = false;
+            }
+      for (Producer* p : producers)
+            p->wait();
+      qDeleteAll(producers);
+      QVERIFY(ok);
+      QVERIFY(drain(q.data(), &next, &count));
+
+      QCOMPARE(count, PRODUCERS * n);
+      for (int i = 0; i < PRODUCERS; ++i)
+            QCOMPARE(next[i], n);
+      QVERIFY(q->empty());
+      }
+
+//---------------------------------------------------------
+//   overflow
+//    every enqueue into a full queue fails and is counted,
+//    the queued items are not touched
+//---------------------------------------------------------
+
+void TestFifo::overflow()
+      {
+      QScopedPointer<Queue> q(new Queue);
+      Producer fill(q.data(), 0, QUEUE_SIZE, false);
+      fill.start();
+      fill.wait();
+      QCOMPARE(fill.failed, 0);
+      QCOMPARE(q->overflows(), 0);
+
+      const int n = 100;
+      QList<Producer*> producers;
+      for (int i = 1; i <= PRODUCERS; ++i)
+            producers.append(new Producer(q.data(), i, n, false));
+      for (Producer* p : producers)
+            p->start();
+      bool allFailed = true;
+      for (Producer* p : producers) {
+            p->wait();
+            allFailed = allFailed && p->failed == n;
+            }
+      qDeleteAll(producers);
+      QVERIFY(allFailed);
+      QCOMPARE(q->overflows(), PRODUCERS * n);
+
+      QVector<int> next(PRODUCERS + 1, 0);
+      int count = 0;
+      QVERIFY(drain(q.data(), &next, &count));
+      QCOMPARE(count, QUEUE_SIZE);
+      QCOMPARE(next[0], QUEUE_SIZE);
+
+      // the queue is usable again after it was drained
+      Item item;
+      item.producer = 0;
+      item.seq      = QUEUE_SIZE;
+      QVERIFY(q->enqueue(item));
+      QVERIFY(drain(q.data(), &next, &count));
+      QCOMPARE(count, QUEUE_SIZE + 1);
+      QCOMPARE(q->overflows(), PRODUCERS * n);
+      }
+
+QTEST_MAIN(TestFifo)
+#include "tst_fifo.moc"
+
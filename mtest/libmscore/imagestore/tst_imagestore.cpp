@@ -0,0 +1,177 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/image.h"
+#include "libmscore/imageStore.h"
+#include "libmscore/score.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestImageStore
+//---------------------------------------------------------
+
+class TestImageStore : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QByteArray png(const QColor& color, int size) const;
+      Image* image(const QString& name, const QByteArray& data);
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void addAndLookup();
+      void trimUnused();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestImageStore::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestImageStore::cleanupTestCase()
+      {
+      imageStore.setUnusedLimit(qint64(MScore::unusedImageLimit) * 1024);
+      }
+
+//---------------------------------------------------------
+//   png
+//    return a square image of one color as png data
+//---------------------------------------------------------
+
+QByteArray TestImageStore::png(const QColor& color, int size) const
+      {
+      QImage img(size, size, QImage::Format_ARGB32);
+      img.fill(color);
+      QByteArray ba;
+      QBuffer buffer(&ba);
+      buffer.open(QIODevice::WriteOnly);
+      img.save(&buffer, "PNG");
+      return ba;
+      }
+
+//---------------------------------------------------------
+//   image
+//---------------------------------------------------------
+
+Image* TestImageStore::image(const QString& name, const QByteArray& data)
+      {
+      Image* img = new Image(score);
+      img->loadFromData(name, data);
+      return img;
+      }
+
+//---------------------------------------------------------
+//   addAndLookup
+//    items are found by hash, equal data is stored once
+//    and decoded rasters are shared
+//---------------------------------------------------------
+
+void TestImageStore::addAndLookup()
+      {
+      QByteArray data = png(Qt::red, 40);
+      Image* a = image("a.png", data);
+      ImageStoreItem* item = a->storeItem();
+      QVERIFY(item);
+      QCOMPARE(imageStore.getImage(item->hashName()), item);
+
+      int items = imageStore.size();
+      Image* b = image("b.png", data);
+      QCOMPARE(b->storeItem(), item);
+      QCOMPARE(imageStore.size(), items);
+
+      QImage i1 = item->image();
+      QImage i2 = item->image();
+      QVERIFY(!i1.isNull());
+      QCOMPARE(i1.size(), QSize(40, 40));
+      QCOMPARE(i1.cacheKey(), i2.cacheKey());
+
+      QPixmap p1 = item->pixmap(QSize(20, 20));
+      QPixmap p2 = item->pixmap(QSize(20, 20));
+      QCOMPARE(p1.size(), QSize(20, 20));
+      QCOMPARE(p1.cacheKey(), p2.cacheKey());
+
+      delete a;
+      QCOMPARE(imageStore.getImage(item->hashName()), item);
+      delete b;
+      }
+
+//---------------------------------------------------------
+//   trimUnused
+//    unreferenced items are deleted least recently used
+//    first once they exceed the limit, adding their data
+//    again brings them back
+//---------------------------------------------------------
+
+void TestImageStore::trimUnused()
+      {
+      QByteArray data1 = png(Qt::green, 50);
+      QByteArray data2 = png(Qt::blue, 60);
+      QByteArray data3 = png(Qt::yellow, 70);
+
+      // drop what previous tests left, then let any single
+      // item fit into the limit but not two of them
+      imageStore.setUnusedLimit(0);
+      imageStore.setUnusedLimit(qMax(data1.size(), qMax(data2.size(), data3.size())));
+
+      Image* a1 = image("1.png", data1);
+      Image* a2 = image("2.png", data2);
+      Image* a3 = image("3.png", data3);
+      QString name1 = a1->storeItem()->hashName();
+      QString name2 = a2->storeItem()->hashName();
+      QString name3 = a3->storeItem()->hashName();
+
+      // referenced items are never trimmed
+      QVERIFY(imageStore.getImage(name1));
+      QVERIFY(imageStore.getImage(name2));
+      QVERIFY(imageStore.getImage(name3));
+
+      delete a1;
+      QVERIFY(imageStore.getImage(name1));
+      delete a2;
+      QVERIFY(!imageStore.getImage(name1));
+      QVERIFY(imageStore.getImage(name2));
+      delete a3;
+      QVERIFY(!imageStore.getImage(name2));
+      ImageStoreItem* item3 = imageStore.getImage(name3);
+      QVERIFY(item3);
+
+      // re-adding kept data reuses the item
+      Image* b3 = image("3.png", data3);
+      QCOMPARE(b3->storeItem(), item3);
+
+      // re-adding trimmed data creates it again
+      Image* b1 = image("1.png", data1);
+      QCOMPARE(b1->storeItem()->hashName(), name1);
+      QCOMPARE(imageStore.getImage(name1), b1->storeItem());
+      QCOMPARE(b1->storeItem()->buffer(), data1);
+      QVERIFY(!b1->storeItem()->image().isNull());
+
+      delete b1;
+      delete b3;
+      }
+
+QTEST_MAIN(TestImageStore)
+#include "tst_imagestore.moc"
+
@@ -0,0 +1,137 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/instrtemplate.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestInstrumentTemplate
+//---------------------------------------------------------
+
+class TestInstrumentTemplate : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QTemporaryDir dir;
+      QString instrumentsPath;
+
+      QByteArray savedTemplates(const QString& name);
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void templateCache();
+      void loadXmlBenchmark();
+      void loadCacheBenchmark();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestInstrumentTemplate::initTestCase()
+      {
+      initMTest();
+      QVERIFY(dir.isValid());
+      instrumentsPath = dir.path() + "/instruments.xml";
+      QVERIFY(QFile::copy(":/instruments.xml", instrumentsPath));
+      }
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestInstrumentTemplate::cleanupTestCase()
+      {
+      setInstrumentTemplateCache(QString(), QString());
+      clearInstrumentTemplates();
+      loadInstrumentTemplates(":/instruments.xml");
+      }
+
+//---------------------------------------------------------
+//   savedTemplates
+//    write the current tables as xml and return them
+//---------------------------------------------------------
+
+QByteArray TestInstrumentTemplate::savedTemplates(const QString& name)
+      {
+      QString path = dir.path() + "/" + name;
+      if (!saveInstrumentTemplates(path))
+            return QByteArray();
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly))
+            return QByteArray();
+      return f.readAll();
+      }
+
+//---------------------------------------------------------
+//   templateCache
+//    tables read from the cache equal the parsed ones
+//---------------------------------------------------------
+
+void TestInstrumentTemplate::templateCache()
+      {
+      QString cacheDir = dir.path() + "/cache";
+      setInstrumentTemplateCache(cacheDir, QString());
+
+      clearInstrumentTemplates();
+      QVERIFY(loadInstrumentTemplates(instrumentsPath));
+      QCOMPARE(QDir(cacheDir).entryList(QStringList("*.cache")).size(), 1);
+      QByteArray fromXml = savedTemplates("fromXml.xml");
+      QVERIFY(!fromXml.isEmpty());
+
+      clearInstrumentTemplates();
+      QVERIFY(loadInstrumentTemplates(instrumentsPath));
+      QVERIFY(searchTemplate("piano"));
+      QCOMPARE(savedTemplates("fromCache.xml"), fromXml);
+
+      // a different translation must not use the cached names
+      setInstrumentTemplateCache(cacheDir, "other");
+      clearInstrumentTemplates();
+      QVERIFY(loadInstrumentTemplates(instrumentsPath));
+      QCOMPARE(savedTemplates("fromOther.xml"), fromXml);
+      }
+
+//---------------------------------------------------------
+//   loadXmlBenchmark
+//---------------------------------------------------------
+
+void TestInstrumentTemplate::loadXmlBenchmark()
+      {
+      setInstrumentTemplateCache(QString(), QString());
+      QBENCHMARK {
+            clearInstrumentTemplates();
+            loadInstrumentTemplates(instrumentsPath);
+            }
+      }
+
+//---------------------------------------------------------
+//   loadCacheBenchmark
+//---------------------------------------------------------
+
+void TestInstrumentTemplate::loadCacheBenchmark()
+      {
+      setInstrumentTemplateCache(dir.path() + "/cache", QString());
+      clearInstrumentTemplates();
+      loadInstrumentTemplates(instrumentsPath);       // make sure the cache is current
+      QBENCHMARK {
+            clearInstrumentTemplates();
+            loadInstrumentTemplates(instrumentsPath);
+            }
+      }
+
+QTEST_MAIN(TestInstrumentTemplate)
+#include "tst_instrumenttemplate.moc"
@@ -14,6 +14,7 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/elementpool.h"
 
 #define DIR QString("libmscore/layout/")
 
@@ -40,6 +41,7 @@ class TestBenchmark : public QObject, public MTest
       void benchmark1();
       void benchmark2();
       void benchmark4();            // incremental layout (one page)
+      void benchmark5();            // load and delete, element pool statistics
       };
 
 //---------------------------------------------------------
@@ -90,6 +92,24 @@ void TestBenchmark::benchmark4()
             }
       }
 
+void TestBenchmark::benchmark5()
+      {
+      QHash<const ElementPool*, int> live;
+      for (const ElementPool* p : ElementPool::allPools())
+            live[p] = p->live();
+      QBENCHMARK {
+            MasterScore* s = readScore(DIR + "goldberg.mscx");
+            delete s;
+            }
+      ElementPool::dumpStatistics();
+      // pools created while reading start from zero
+      for (const ElementPool* p : ElementPool::allPools()) {
+            QCOMPARE(p->live(), live.value(p, 0));
+            if (p->live() == 0)
+                  QVERIFY(p->chunks() <= 1);
+            }
+      }
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
 
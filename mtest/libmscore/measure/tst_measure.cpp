@@ -59,6 +59,7 @@ class TestMeasure : public QObject, public MTest
 
       void gap();
       void checkMeasure();
+      void tick2measure();
       };
 
 //---------------------------------------------------------
@@ -459,7 +460,38 @@ void TestMeasure::checkMeasure()
       delete score;
       }
 
+//---------------------------------------------------------
+///   tick2measure
+///   measure index lookup after inserting and removing measures
+//---------------------------------------------------------
 
+void TestMeasure::tick2measure()
+      {
+      MasterScore* score = readScore(DIR + "measure-1.mscx");
+
+      // QCOMPARE and QVERIFY would only return from the lambda
+      auto check = [score]() -> bool {
+            for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+                  if (score->tick2measure(m->tick()) != m || score->tick2measure(m->endTick() - 1) != m) {
+                        qDebug("tick2measure: wrong measure at tick %d", m->tick());
+                        return false;
+                        }
+                  }
+            return score->tick2measure(score->lastMeasure()->endTick()) == score->lastMeasure()
+               && score->tick2measure(score->lastMeasure()->endTick() + 1) == 0;
+            };
+      QVERIFY(check());
+
+      score->startCmd();
+      score->insertMeasure(ElementType::MEASURE, score->firstMeasure()->nextMeasure());
+      score->endCmd();
+      QVERIFY(check());
+
+      score->undoRedo(true, 0);
+      QVERIFY(check());
+
+      delete score;
+      }
 
 QTEST_MAIN(TestMeasure)
 
@@ -23,6 +23,10 @@
 #include "libmscore/chord.h"
 #include "libmscore/note.h"
 #include "libmscore/keysig.h"
+#include "libmscore/dynamic.h"
+#include "libmscore/hairpin.h"
+#include "libmscore/staff.h"
+#include "libmscore/part.h"
 #include "mscore/exportmidi.h"
 #include "mscore/preferences.h"
 #include <QIODevice>
@@ -53,6 +57,7 @@ class TestMidi : public QObject, public MTest
       void midi03();
       void events_data();
       void events();
+      void concurrentEvents();
       void midiBendsExport1() { midiExportTestRef("testBends1"); }
       void midiBendsExport2() { midiExportTestRef("testBends2"); }      // Play property test
       void midiPortExport()   { midiExportTestRef("testMidiPort"); }
@@ -398,6 +403,82 @@ void TestMidi::events()
      // QVERIFY(saveCompareScore(score, writeFile, reference));
       }
 
+//---------------------------------------------------------
+//   concurrentEvents
+//    the staves rendered concurrently give the same events
+//    in the same order as rendered one after the other, and
+//    the velocities collected in one pass follow dynamics
+//    and hairpins of all staves
+//---------------------------------------------------------
+
+void TestMidi::concurrentEvents()
+      {
+      MasterScore* score = readScore(DIR + "testAndanteExcerpts.mscx");
+      QVERIFY(score);
+      QVERIFY(score->nstaves() > 1);
+
+      EventMap concurrent;
+      score->renderMidi(&concurrent);
+      MScore::noConcurrentMidi = true;
+      EventMap sequential;
+      score->renderMidi(&sequential);
+      MScore::noConcurrentMidi = false;
+
+      QCOMPARE(concurrent.size(), sequential.size());
+      for (auto i = concurrent.begin(), j = sequential.begin(); i != concurrent.end(); ++i, ++j) {
+            QCOMPARE(i->first, j->first);
+            QCOMPARE(i->second.type(), j->second.type());
+            QCOMPARE(i->second.channel(), j->second.channel());
+            QCOMPARE(i->second.dataA(), j->second.dataA());
+            QCOMPARE(i->second.dataB(), j->second.dataB());
+            }
+
+      // of several dynamics for a staff at the same tick one wins
+      QMap<QPair<Staff*, int>, QSet<int>> dynamics;
+      for (Segment* s = score->firstMeasure()->first(); s; s = s->next1()) {
+            for (Element* e : s->annotations()) {
+                  if (!e->isDynamic() || toDynamic(e)->velocity() < 1)
+                        continue;
+                  Dynamic* d = toDynamic(e);
+                  QList<Staff*> staves;
+                  switch (d->dynRange()) {
+                        case Dynamic::Range::STAFF:
+                              staves.append(d->staff());
+                              break;
+                        case Dynamic::Range::PART:
+                              staves = *d->part()->staves();
+                              break;
+                        case Dynamic::Range::SYSTEM:
+                              staves = score->staves();
+                              break;
+                        }
+                  for (Staff* st : staves)
+                        dynamics[qMakePair(st, s->tick())].insert(d->velocity());
+                  }
+            }
+      QVERIFY(dynamics.size() > 1);
+      for (auto i = dynamics.begin(); i != dynamics.end(); ++i)
+            QVERIFY(i.value().contains(i.key().first->velocities().velo(i.key().second)));
+
+      int hairpins = 0;
+      for (const auto& sp : score->spanner()) {
+            if (!sp.second->isHairpin())
+                  continue;
+            Hairpin* h = toHairpin(sp.second);
+            const VeloList& velo = h->staff()->velocities();
+            int start = velo.velo(h->tick());
+            int end   = velo.velo(h->tick2() - 1);
+            if (h->hairpinType() == HairpinType::CRESC_HAIRPIN || h->hairpinType() == HairpinType::CRESC_LINE)
+                  QVERIFY(end >= start);
+            else
+                  QVERIFY(end <= start);
+            ++hairpins;
+            }
+      QVERIFY(hairpins > 1);
+
+      delete score;
+      }
+
 //---------------------------------------------------------
 //   midiExportTest
 //   read a MuseScore mscx file, write to a MIDI file and verify against reference
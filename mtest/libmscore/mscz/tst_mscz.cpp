@@ -0,0 +1,167 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/score.h"
+#include "thirdparty/qzip/qzipreader_p.h"
+#include "thirdparty/qzip/qzipwriter_p.h"
+#include "mtest/testutils.h"
+
+#define DIR QString("libmscore/mscz/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestMscz
+//---------------------------------------------------------
+
+class TestMscz : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QByteArray readStreamed(const MQZipReader& uz, const QString& name, int chunkSize) const;
+
+   private slots:
+      void initTestCase();
+      void streamEntries();
+      void roundTrip();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestMscz::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   readStreamed
+//    read an entry through the inflating device in
+//    pieces of chunkSize bytes
+//---------------------------------------------------------
+
+QByteArray TestMscz::readStreamed(const MQZipReader& uz, const QString& name, int chunkSize) const
+      {
+      QScopedPointer<QIODevice> dev(uz.openFile(name));
+      if (!dev)
+            return QByteArray();
+      QByteArray data;
+      for (;;) {
+            QByteArray chunk = dev->read(chunkSize);
+            if (chunk.isEmpty())
+                  break;
+            data += chunk;
+            }
+      return data;
+      }
+
+//---------------------------------------------------------
+//   streamEntries
+//    an entry deflated through openFile() in small writes
+//    reads back equal through fileData() and openFile(),
+//    entries keep the order in which they were added
+//---------------------------------------------------------
+
+void TestMscz::streamEntries()
+      {
+      // larger than the 64k inflate window, not too regular
+      QByteArray big;
+      for (int i = 0; i < 50000; ++i)
+            big += QByteArray::number((i * 7919) % 10007) + ' ';
+      QByteArray small("<container/>");
+
+      QByteArray zip;
+      QBuffer out(&zip);
+      out.open(QIODevice::WriteOnly);
+      {
+      MQZipWriter uz(&out);
+      uz.addFile("first.xml", small);
+      QIODevice* dev = uz.openFile("big.txt");
+      QVERIFY(dev);
+      for (int pos = 0; pos < big.size(); pos += 1000)
+            QCOMPARE(dev->write(big.mid(pos, 1000)), qint64(qMin(1000, big.size() - pos)));
+      delete dev;
+      uz.addFile("last.xml", small);
+      uz.close();
+      QCOMPARE(uz.status(), MQZipWriter::NoError);
+      }
+
+      QBuffer in(&zip);
+      in.open(QIODevice::ReadOnly);
+      MQZipReader uz(&in);
+      QList<MQZipReader::FileInfo> entries = uz.fileInfoList();
+      QCOMPARE(entries.size(), 3);
+      QCOMPARE(entries[0].filePath, QString("first.xml"));
+      QCOMPARE(entries[1].filePath, QString("big.txt"));
+      QCOMPARE(entries[2].filePath, QString("last.xml"));
+      QCOMPARE(entries[1].size, qint64(big.size()));
+
+      QCOMPARE(uz.fileData("big.txt"), big);
+      QCOMPARE(readStreamed(uz, "big.txt", 4096), big);
+      QCOMPARE(readStreamed(uz, "big.txt", 100000), big);
+      QCOMPARE(uz.fileData("last.xml"), small);
+      QVERIFY(!uz.openFile("missing.txt"));
+      }
+
+//---------------------------------------------------------
+//   roundTrip
+//    save a score as .mscz and load it again, the container
+//    comes first and the streamed score is the same as
+//    the uncompressed one
+//---------------------------------------------------------
+
+void TestMscz::roundTrip()
+      {
+      MasterScore* score = readScore(DIR + "mscz.mscx");
+      QVERIFY(score);
+
+      QBuffer mscx;
+      mscx.open(QIODevice::WriteOnly);
+      QVERIFY(score->Score::saveFile(&mscx, true));
+
+      QByteArray mscz;
+      QBuffer out(&mscz);
+      out.open(QIODevice::WriteOnly);
+      QFileInfo fi("mscz.mscz");
+      QVERIFY(score->saveCompressedFile(&out, fi, false, false));
+
+      QBuffer in(&mscz);
+      in.open(QIODevice::ReadOnly);
+      {
+      MQZipReader uz(&in);
+      QList<MQZipReader::FileInfo> entries = uz.fileInfoList();
+      QVERIFY(entries.size() >= 2);
+      QCOMPARE(entries.first().filePath, QString("META-INF/container.xml"));
+      QCOMPARE(entries.last().filePath, QString("mscz.mscx"));
+      QCOMPARE(uz.fileData("mscz.mscx"), mscx.data());
+      QCOMPARE(readStreamed(uz, "mscz.mscx", 1000), mscx.data());
+      }
+
+      in.open(QIODevice::ReadOnly);       // closed by the reader
+      MasterScore* loaded = new MasterScore(mscore->baseStyle());
+      QCOMPARE(loaded->loadMsc("mscz.mscz", &in, false), Score::FileError::FILE_NO_ERROR);
+      loaded->doLayout();
+      QBuffer again;
+      again.open(QIODevice::WriteOnly);
+      QVERIFY(loaded->Score::saveFile(&again, true));
+      QCOMPARE(again.data(), mscx.data());
+
+      delete loaded;
+      delete score;
+      }
+
+QTEST_MAIN(TestMscz)
+#include "tst_mscz.moc"
+
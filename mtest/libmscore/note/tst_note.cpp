@@ -21,11 +21,13 @@
 #include "libmscore/chord.h"
 #include "libmscore/measure.h"
 #include "libmscore/segment.h"
+#include "libmscore/stem.h"
 #include "libmscore/tremolo.h"
 #include "libmscore/articulation.h"
 #include "libmscore/sym.h"
 #include "libmscore/key.h"
 #include "libmscore/pitchspelling.h"
+#include "libmscore/undo.h"
 #include "mtest/testutils.h"
 
 #define DIR QString("libmscore/note/")
@@ -50,6 +52,8 @@ class TestNote : public QObject, public MTest
       void noteLimits();
       void tpcDegrees();
       void LongNoteAfterShort_183746();
+      void undoHistory();
+      void undoMemoryUsage();
       };
 
 //---------------------------------------------------------
@@ -537,6 +541,120 @@ void TestNote::LongNoteAfterShort_183746() {
       QVERIFY(totalTicks == TDuration(TDuration::DurationType::V_BREVE).ticks()); // total duration same as a breve
       }
 
+//---------------------------------------------------------
+///   undoHistory
+///   changes of one property coalesce and the history
+///   is bounded by MScore::undoMemoryLimit
+//---------------------------------------------------------
+
+void TestNote::undoHistory()
+      {
+      MasterScore* score = readScore(DIR + "empty.mscx");
+      score->doLayout();
+
+      score->inputState().setTrack(0);
+      score->inputState().setSegment(score->tick2segment(0, false, SegmentType::ChordRest));
+      score->inputState().setDuration(TDuration::DurationType::V_QUARTER);
+      score->inputState().setNoteEntryMode(true);
+      score->cmdAddPitch(5 * 7 + 1, false, false);
+
+      Element* e = score->tick2segment(0, false, SegmentType::ChordRest)->element(0);
+      QVERIFY(e && e->isChord());
+      Note* note = toChord(e)->upNote();
+      UndoStack* us = score->undoStack();
+      int entries = us->size();
+
+      score->startCmd();
+      note->undoChangeProperty(P_ID::COLOR, QColor(Qt::red));
+      int children = us->current()->childCount();
+      note->undoChangeProperty(P_ID::COLOR, QColor(Qt::blue));
+      QCOMPARE(us->current()->childCount(), children);
+      score->endCmd();
+
+      QCOMPARE(us->size(), entries + 1);
+      // one property change, no element is owned by the entry
+      QVERIFY(us->memoryUsage(entries) >= int(sizeof(ChangeProperty)));
+      QVERIFY(us->memoryUsage(entries) < int(sizeof(Note)));
+      us->undo(0);
+      QCOMPARE(note->color(), MScore::defaultColor);
+      us->redo(0);
+      QCOMPARE(note->color(), QColor(Qt::blue));
+
+      int limit = MScore::undoMemoryLimit;
+      MScore::undoMemoryLimit = 1;        // kB
+      for (int i = 0; i < 50; ++i) {
+            score->startCmd();
+            note->undoChangeProperty(P_ID::COLOR, QColor(i, 0, 0));
+            score->endCmd();
+            }
+      MScore::undoMemoryLimit = limit;
+
+      QVERIFY(us->size() < entries + 51);
+      QVERIFY(us->memoryUsage() <= 1024 || us->size() == 1);
+      QVERIFY(!us->isClean());
+      while (us->canUndo())
+            us->undo(0);
+      QVERIFY(us->canRedo());
+      delete score;
+      }
+
+//---------------------------------------------------------
+///   undoMemoryUsage
+///   entries report the size of the element trees they
+///   own, elements which are part of the score are not
+///   counted
+//---------------------------------------------------------
+
+void TestNote::undoMemoryUsage()
+      {
+      MasterScore* score = readScore(DIR + "empty.mscx");
+      score->doLayout();
+      UndoStack* us = score->undoStack();
+      int entries = us->size();
+
+      score->inputState().setTrack(0);
+      score->inputState().setSegment(score->tick2segment(0, false, SegmentType::ChordRest));
+      score->inputState().setDuration(TDuration::DurationType::V_QUARTER);
+      score->inputState().setNoteEntryMode(true);
+      score->cmdAddPitch(5 * 7 + 1, false, false);
+      QCOMPARE(us->size(), entries + 1);
+      // the added chord is part of the score
+      int chordSize = int(sizeof(Chord) + sizeof(Note) + sizeof(Stem));
+      QVERIFY(us->memoryUsage(entries) < chordSize);
+      // once undone the entry owns it
+      us->undo(0);
+      QVERIFY(us->memoryUsage(entries) >= chordSize);
+      us->redo(0);
+      QVERIFY(us->memoryUsage(entries) < chordSize);
+
+      Measure* m = score->firstMeasure();
+      int segments = 0;
+      for (Segment* s = m->first(); s; s = s->next())
+            ++segments;
+      QVERIFY(segments > 1);
+
+      score->startCmd();
+      score->undoRemoveMeasures(m, m);
+      score->endCmd();
+      QCOMPARE(us->size(), entries + 2);
+      QVERIFY(score->firstMeasure() != m);
+      int size = int(sizeof(Measure) + segments * sizeof(Segment) + sizeof(Chord) + sizeof(Note));
+      QVERIFY(us->memoryUsage(entries + 1) >= size);
+      qint64 total = 0;
+      for (int i = 0; i < us->size(); ++i)
+            total += us->memoryUsage(i);
+      QCOMPARE(us->memoryUsage(), total);
+
+      us->undo(0);
+      QCOMPARE(score->firstMeasure(), m);
+      QVERIFY(us->memoryUsage(entries + 1) < int(sizeof(Measure)));
+      total = 0;
+      for (int i = 0; i < us->size(); ++i)
+            total += us->memoryUsage(i);
+      QCOMPARE(us->memoryUsage(), total);
+      delete score;
+      }
+
 QTEST_MAIN(TestNote)
 
 #include "tst_note.moc"
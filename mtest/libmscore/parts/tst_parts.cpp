@@ -29,12 +29,27 @@
 #include "libmscore/sym.h"
 #include "libmscore/chordline.h"
 #include "libmscore/sym.h"
+#include "libmscore/system.h"
+#include "libmscore/mscoreview.h"
 #include "mtest/testutils.h"
 
 #define DIR QString("libmscore/parts/")
 
 using namespace Ms;
 
+//---------------------------------------------------------
+//   StubView
+//    a view which only makes the score count as shown
+//---------------------------------------------------------
+
+class StubView : public MuseScoreView {
+   public:
+      virtual void dataChanged(const QRectF&) override {}
+      virtual void updateAll() override {}
+      virtual void drawBackground(QPainter*, const QRectF&) const override {}
+      virtual const QRect geometry() const override { return QRect(); }
+      };
+
 //---------------------------------------------------------
 //   TestParts
 //---------------------------------------------------------
@@ -45,6 +60,8 @@ class TestParts : public QObject, public MTest
 
       void createParts(MasterScore* score);
       void testPartCreation(const QString& test);
+      int flipStem(MasterScore* score, int measureIdx);
+      QStringList layoutPositions(Score* score) const;
 
       MasterScore* doAddBreath();
       MasterScore* doRemoveBreath();
@@ -113,6 +130,7 @@ class TestParts : public QObject, public MTest
 //      void staffStyles();
 
       void measureProperties();
+      void deferredLayout();
 
  // second part has system text on empty chordrest segment
       void createPart3() {
@@ -1047,6 +1065,108 @@ void TestParts::measureProperties()
       {
       }
 
+//---------------------------------------------------------
+//   flipStem
+//    point the stem of the first chord of a measure in the
+//    first staff down, return its tick
+//---------------------------------------------------------
+
+int TestParts::flipStem(MasterScore* score, int measureIdx)
+      {
+      Measure* m = score->firstMeasure();
+      for (int i = 0; i < measureIdx; ++i)
+            m = m->nextMeasure();
+      Segment* s = m->first(SegmentType::ChordRest);
+      while (s && !(s->element(0) && s->element(0)->isChord()))
+            s = s->next(SegmentType::ChordRest);
+      score->startCmd();
+      s->element(0)->undoChangeProperty(P_ID::STEM_DIRECTION, QVariant::fromValue<Direction>(Direction::DOWN));
+      score->endCmd();
+      return s->tick();
+      }
+
+//---------------------------------------------------------
+//   layoutPositions
+//    system, position and width of every measure and
+//    segment of a laid out score
+//---------------------------------------------------------
+
+QStringList TestParts::layoutPositions(Score* score) const
+      {
+      QStringList l;
+      l.append(QString("pages %1 systems %2").arg(score->npages()).arg(score->systems().size()));
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            l.append(QString("measure %1 system %2 x %3 w %4")
+               .arg(m->tick()).arg(score->systems().indexOf(m->system())).arg(m->pos().x()).arg(m->width()));
+            for (Segment* s = m->first(); s; s = s->next())
+                  l.append(QString("   segment %1 x %2 w %3").arg(s->tick()).arg(s->pos().x()).arg(s->width()));
+            }
+      return l;
+      }
+
+//---------------------------------------------------------
+//   deferredLayout
+//    while the master score is shown in a view, a part
+//    without a view collects the layout ranges of several
+//    commands and, laid out later, ends up as if it was
+//    laid out after every command
+//---------------------------------------------------------
+
+void TestParts::deferredLayout()
+      {
+      MasterScore* immediate = readScore(DIR + "part-all.mscx");
+      createParts(immediate);
+      immediate->doLayout();
+      MasterScore* deferred = readScore(DIR + "part-all.mscx");
+      createParts(deferred);
+      deferred->doLayout();
+
+      StubView view;
+      view.setScore(deferred);
+      deferred->addViewer(&view);
+      Score* ipart = immediate->excerpts().first()->partScore();
+      Score* dpart = deferred->excerpts().first()->partScore();
+
+      int tick1 = flipStem(immediate, 3);
+      QCOMPARE(flipStem(deferred, 3), tick1);
+      QVERIFY(!ipart->layoutPending());
+      QVERIFY(!deferred->layoutPending());
+      QVERIFY(dpart->layoutPending());
+      QCOMPARE(dpart->pendingStartTick(), tick1);
+
+      // ranges of later commands are merged
+      int tick2 = flipStem(immediate, 1);
+      QCOMPARE(flipStem(deferred, 1), tick2);
+      QVERIFY(tick2 < tick1);
+      QVERIFY(dpart->layoutPending());
+      QCOMPARE(dpart->pendingStartTick(), tick2);
+      QVERIFY(dpart->pendingEndTick() >= tick1);
+      QCOMPARE(layoutPositions(deferred), layoutPositions(immediate));
+
+      // writing the part lays it out
+      QVERIFY(saveScore(deferred, "part-deferred.mscx"));
+      QVERIFY(!dpart->layoutPending());
+      QCOMPARE(layoutPositions(dpart), layoutPositions(ipart));
+
+      int tick3 = flipStem(immediate, 4);
+      QCOMPARE(flipStem(deferred, 4), tick3);
+      QVERIFY(dpart->layoutPending());
+      QCOMPARE(dpart->pendingStartTick(), tick3);
+      dpart->doPendingLayout();
+      QVERIFY(!dpart->layoutPending());
+      QCOMPARE(layoutPositions(dpart), layoutPositions(ipart));
+
+      // the other part was deferred as well
+      Score* ipart2 = immediate->excerpts().at(1)->partScore();
+      Score* dpart2 = deferred->excerpts().at(1)->partScore();
+      QVERIFY(dpart2->layoutPending());
+      dpart2->doPendingLayout();
+      QCOMPARE(layoutPositions(dpart2), layoutPositions(ipart2));
+
+      deferred->removeViewer(&view);
+      delete immediate;
+      delete deferred;
+      }
 
 QTEST_MAIN(TestParts)
 
@@ -52,6 +52,7 @@ class TestSpanners : public QObject, public MTest
       void spanners12();            // remove a measure containing the middle portion of a LyricsLine and undo
 //      void spanners13();            // drop a line break at the middle of a LyricsLine and check LyricsLineSegments
       void spanners14();            // creating part from an existing grand staff containing a cross staff glissando
+      void spanners15();            // spanner map follows tick changes of its spanners
       };
 
 //---------------------------------------------------------
@@ -621,7 +622,53 @@ void TestSpanners::spanners14()
       delete score;
       }
 
+//---------------------------------------------------------
+///  spanners15
+///   moving a spanner updates the spanner map without a rebuild
+//---------------------------------------------------------
 
+void TestSpanners::spanners15()
+      {
+      MasterScore* score = readScore(DIR + "lyricsline01.mscx");
+      QVERIFY(score);
+      SpannerMap& smap = score->spannerMap();
+      QVERIFY(!smap.map().empty());
+
+      Spanner* sp = smap.cbegin()->second;
+      int tick    = sp->tick();
+      int ticks   = sp->ticks();
+      int far     = score->lastMeasure()->endTick() + 100 * MScore::division;
+
+      auto hits = [&smap, sp](int from, int to) {
+            for (auto i : smap.findOverlapping(from, to)) {
+                  if (i.value == sp)
+                        return true;
+                  }
+            return false;
+            };
+
+      QVERIFY(hits(tick, tick + ticks));
+      QVERIFY(!hits(far, far + ticks));
+
+      sp->setTick(far);
+      QVERIFY(hits(far, far + ticks));
+      QVERIFY(!hits(far + ticks + 1, far + 2 * ticks + 1));
+
+      sp->setTicks(2 * ticks + 1);
+      QVERIFY(hits(far + ticks + 1, far + 2 * ticks + 1));
+      QVERIFY(!smap.findContained(far, far + 2 * ticks + 1).empty());
+
+      sp->setTick(tick);
+      sp->setTicks(ticks);
+      QVERIFY(hits(tick, tick + ticks));
+      QVERIFY(!hits(far, far + ticks));
+
+      smap.removeSpanner(sp);
+      QVERIFY(!hits(tick, tick + ticks));
+      smap.addSpanner(sp);
+      QVERIFY(hits(tick, tick + ticks));
+      delete score;
+      }
 
 QTEST_MAIN(TestSpanners)
 #include "tst_spanners.moc"
@@ -0,0 +1,101 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/text.h"
+#include "libmscore/score.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestTextMetrics
+//---------------------------------------------------------
+
+class TestTextMetrics : public QObject, public MTest
+      {
+      Q_OBJECT
+
+   private slots:
+      void initTestCase();
+      void cachedEqualsUncached();
+      void evictLeastRecentlyUsed();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestTextMetrics::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   cachedEqualsUncached
+//    fragment metrics from the cache are the same as
+//    measured without it, on a miss and on a hit
+//---------------------------------------------------------
+
+void TestTextMetrics::cachedEqualsUncached()
+      {
+      QFont serif("FreeSerif");
+      serif.setPointSizeF(12.0);
+      QFont bold(serif);
+      bold.setBold(true);
+      bold.setItalic(true);
+      QFont small("FreeSans");
+      small.setPointSizeF(7.0);
+
+      for (const QFont& font : { serif, bold, small }) {
+            for (const QString& s : { QString("Allegro"), QString("ly"), QString("C7b9"), QString::fromUtf8("été") }) {
+                  FragmentMetrics uncached = TextMetricsCache::measure(font, s);
+                  for (int pass = 0; pass < 2; ++pass) {
+                        QString text(s);
+                        FragmentMetrics cached = textMetricsCache.metrics(font, text);
+                        QCOMPARE(text, s);
+                        QCOMPARE(cached.width, uncached.width);
+                        QCOMPARE(cached.lineSpacing, uncached.lineSpacing);
+                        QCOMPARE(cached.xHeight, uncached.xHeight);
+                        QCOMPARE(cached.tightBoundingRect, uncached.tightBoundingRect);
+                        QVERIFY(textMetricsCache.contains(font, s));
+                        }
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   evictLeastRecentlyUsed
+//    a full cache drops the entry used longest ago
+//---------------------------------------------------------
+
+void TestTextMetrics::evictLeastRecentlyUsed()
+      {
+      TextMetricsCache cache(2);
+      QFont font("FreeSerif");
+      QString a("a");
+      QString b("b");
+      QString c("c");
+
+      cache.metrics(font, a);
+      cache.metrics(font, b);
+      cache.metrics(font, a);
+      cache.metrics(font, c);
+      QVERIFY(cache.contains(font, "a"));
+      QVERIFY(!cache.contains(font, "b"));
+      QVERIFY(cache.contains(font, "c"));
+      }
+
+QTEST_MAIN(TestTextMetrics)
+#include "tst_textmetrics.moc"
+
@@ -172,6 +172,8 @@ private slots:
       void words2() { mxmlIoTest("testWords2"); }
       void sound1() { mxmlIoTestRef("testSound1"); }
       void sound2() { mxmlIoTestRef("testSound2"); }
+
+      void importBenchmark();
       };
 
 //---------------------------------------------------------
@@ -183,6 +185,27 @@ void TestMxmlIO::initTestCase()
       initMTest();
       }
 
+//---------------------------------------------------------
+//   importBenchmark
+//   import all MusicXML test files
+//---------------------------------------------------------
+
+void TestMxmlIO::importBenchmark()
+      {
+      QStringList files;
+      for (const QString& file : QDir(root + "/" + DIR).entryList(QStringList("test*.xml"), QDir::Files)) {
+            if (!file.endsWith("_ref.xml"))
+                  files.append(file);
+            }
+      QVERIFY(!files.isEmpty());
+      MScore::skipXmlValidation = true;         // measure the importer only
+      QBENCHMARK {
+            for (const QString& file : files)
+                  delete readScore(DIR + file);
+            }
+      MScore::skipXmlValidation = false;
+      }
+
 //---------------------------------------------------------
 //   fixupScore -- do required fixups after MusicXML import
 //   see mscore/file.cpp MuseScore::readScore(Score* score, QString name)
@@ -14,6 +14,7 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "omr/omr.h"
 
 #define DIR QString("omr/notes/")
 
@@ -33,6 +34,7 @@ class TestNotes : public QObject, public MTest
       void initTestCase();
       //void notes2() { omrFileTest("notes2"); }
       //void notes1() { omrFileTest("notes1"); }
+      void omrBenchmark();
       };
 
 //---------------------------------------------------------
@@ -64,6 +66,31 @@ void TestNotes::omrFileTest(QString file)
       QVERIFY(saveCompareScore(score1, file + ".mscx", DIR + file + "-ref.mscx"));
       }
 
+//---------------------------------------------------------
+//   omrBenchmark
+//    recognize a rendered score without gui and report
+//    the throughput in pages per second
+//---------------------------------------------------------
+
+void TestNotes::omrBenchmark()
+      {
+      MasterScore* score = readScore(DIR + "notes1.mscx");
+      QVERIFY(score);
+      score->doLayout();
+      QVERIFY(savePdf(score, "notes1-benchmark.pdf"));
+
+      int pages = 0;
+      QElapsedTimer timer;
+      timer.start();
+      QBENCHMARK {
+            Omr omr("notes1-benchmark.pdf", score);
+            QVERIFY(omr.readPdf());
+            pages += omr.numPages();
+            }
+      qDebug("%.2f pages/s", pages * 1000.0 / qMax(qint64(1), timer.elapsed()));
+      delete score;
+      }
+
 QTEST_MAIN(TestNotes)
 #include "tst_notes.moc"
 
@@ -18,8 +18,10 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 
+#include <QtConcurrent/QtConcurrentMap>
 #include "omr.h"
 #include "omrview.h"
+#include "libmscore/mscore.h"
 #include "libmscore/xml.h"
 #include "libmscore/sym.h"
 #include "omrpage.h"
@@ -56,7 +58,6 @@ Omr::Omr(Score* s)
       _ocr = 0;
 #endif
       ActionNames = QList<QString>() << QWidget::tr("Loading PDF") << QWidget::tr("Initializing Staves") << QWidget::tr("Identifying Systems");
-      initUtils();
       }
 
 Omr::Omr(const QString& p, Score* s)
@@ -65,7 +66,6 @@ Omr::Omr(const QString& p, Score* s)
       _path         = p;
       _ocr          = 0;
       ActionNames = QList<QString>()<< QWidget::tr("Loading PDF") << QWidget::tr("Initializing Staves") << QWidget::tr("Load Parameters") << QWidget::tr("Identifying Systems");
-      initUtils();
       }
 
 //---------------------------------------------------------
@@ -142,55 +142,78 @@ int Omr::pagesInDocument() const
 
 bool Omr::readPdf()
       {
+      if (MScore::noGui)
+            return process(0);
+
       QProgressDialog *progress = new QProgressDialog(QWidget::tr("Reading PDF..."), QWidget::tr("Cancel"), 0, 100, 0, Qt::FramelessWindowHint);
       progress->setWindowModality(Qt::ApplicationModal);
       progress->show();
-      progress->setRange(0, ACTION_NUM);
+      bool val = process(progress);
+      progress->close();
+      delete progress;
+      return val;
+      }
 
+//---------------------------------------------------------
+//   process
+//    run all recognition steps; progress is 0 when
+//    running without gui
+//---------------------------------------------------------
+
+bool Omr::process(QProgressDialog* progress)
+      {
 #ifdef OCR
       if (_ocr == 0)
             _ocr = new Ocr;
       _ocr->init();
 #endif
-      int ID = READ_PDF;
-      int page = 0;
-      bool val;
-      while (ID < ACTION_NUM) {
-            if(ID != INIT_PAGE && ID != SYSTEM_IDENTIFICATION) {
-                  page = 0;
-                  progress->setLabelText(QWidget::tr("%1 at Page %2").arg(ActionNames.at(ID+1)).arg(1));
-                  val = omrActions(ID, page);
-                  }
-            else {
-                  progress->setLabelText(QWidget::tr("%1 at Page %2").arg(ActionNames.at(ID)).arg(page+1));
-                  val = omrActions(ID, page);
-                  page++;
-                  }
-
-            if (!val || progress->wasCanceled()) {
-                  progress->close();
-                  return false;
-                  }
-            else {
-                  if (ID < ACTION_NUM)
-                        progress->setValue(ID);
-                  else
-                        progress->setValue(ACTION_NUM - 1);
+      for (int ID = READ_PDF; ID < ACTION_NUM; ++ID) {
+            if (progress) {
+                  progress->setLabelText(ActionNames.value(ID));
                   qApp->processEvents();
                   }
+            if (!omrActions(ID, progress) || (progress && progress->wasCanceled()))
+                  return false;
             }
-      progress->close();
-      delete progress;
       return true;
       }
 
+//---------------------------------------------------------
+//   processPages
+//    run f for all pages concurrently; if there is a
+//    progress dialog, keep it responsive until all pages
+//    are done
+//---------------------------------------------------------
+
+bool Omr::processPages(const std::function<void(OmrPage*)>& f, QProgressDialog* progress)
+      {
+      QFuture<void> future = QtConcurrent::map(_pages, f);
+      if (!progress) {
+            future.waitForFinished();
+            return true;
+            }
+      QFutureWatcher<void> watcher;
+      QEventLoop loop;
+      QObject::connect(&watcher, &QFutureWatcher<void>::progressRangeChanged, progress, &QProgressDialog::setRange);
+      QObject::connect(&watcher, &QFutureWatcher<void>::progressValueChanged, progress, &QProgressDialog::setValue);
+      QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+      QObject::connect(progress, &QProgressDialog::canceled, &watcher, &QFutureWatcher<void>::cancel);
+      watcher.setFuture(future);
+      if (!future.isFinished())
+            loop.exec();
+      future.waitForFinished();
+      return !future.isCanceled();
+      }
+
 //---------------------------------------------------------
 //   actions
+//    pages are independent once they are loaded, so the
+//    page steps run concurrently
 //---------------------------------------------------------
 
-bool Omr::omrActions(int &ID, int page)
+bool Omr::omrActions(int ID, QProgressDialog* progress)
       {
-      if(ID == READ_PDF) {
+      if (ID == READ_PDF) {
             _doc = new Pdf();
             if (!_doc->open(_path)) {
                   delete _doc;
@@ -198,7 +221,7 @@ bool Omr::omrActions(int &ID, int page)
                   return false;
                   }
             int n = _doc->numPages();
-            printf("readPdf: %d pages\n", n);
+            qDebug("readPdf: %d pages", n);
             for (int i = 0; i < n; ++i) {
                   OmrPage* page = new OmrPage(this);
                   QImage image = _doc->page(i);
@@ -209,26 +232,26 @@ bool Omr::omrActions(int &ID, int page)
                   }
 
             _spatium = 15.0; //constant spatium, image will be rescaled according to this parameter
-            ID++;
             return true;
             }
-      else if(ID == INIT_PAGE) {
-            //load one page and rescale
-            _pages[page]->read();
-
-            //do the rescaling here
-            int new_w = _pages[page]->image().width() * _spatium/_pages[page]->spatium();
-            int new_h = _pages[page]->image().height() * _spatium/_pages[page]->spatium();
-            QImage image = _pages[page]->image().scaled(new_w,new_h, Qt::KeepAspectRatio);
-            _pages[page]->setImage(image);
-            _pages[page]->read();
-
-            if(page == _pages.size()-1)
-                  ID++;
-            return true;
+      else if (ID == INIT_PAGE) {
+            double spatium = _spatium;
+            return processPages([spatium](OmrPage* page) {
+                  //load one page and rescale
+                  page->read();
+
+                  //do the rescaling here
+                  int new_w = page->image().width() * spatium / page->spatium();
+                  int new_h = page->image().height() * spatium / page->spatium();
+                  QImage image = page->image().scaled(new_w, new_h, Qt::KeepAspectRatio);
+                  page->setImage(image);
+                  page->read();
+                  }, progress);
             }
-      else if(ID == FINALIZE_PARMS) {
+      else if (ID == FINALIZE_PARMS) {
             int n = _pages.size();
+            if (n == 0)
+                  return false;
             double w = 0;
             for (int i = 0; i < n; ++i) {
                   w  += _pages[i]->width();
@@ -253,15 +276,10 @@ bool Omr::omrActions(int &ID, int page)
             timesigPattern[7] = new Pattern(_score, SymId::timeSig7, _spatium);
             timesigPattern[8] = new Pattern(_score, SymId::timeSig8, _spatium);
             timesigPattern[9] = new Pattern(_score, SymId::timeSig9, _spatium);
-
-            ID++;
             return true;
-
             }
-      else if(ID == SYSTEM_IDENTIFICATION) {
-            _pages[page]->identifySystems();
-            if(page == _pages.size()-1) ID++;
-            return true;
+      else if (ID == SYSTEM_IDENTIFICATION) {
+            return processPages([](OmrPage* page) { page->identifySystems(); }, progress);
             }
       return false;
       }
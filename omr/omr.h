@@ -50,9 +50,9 @@ class Omr {
       Ocr* _ocr;
       Score* _score;
 
-      static void initUtils();
-
       void process1(int page);
+      bool process(QProgressDialog*);
+      bool processPages(const std::function<void(OmrPage*)>&, QProgressDialog*);
 
 
       enum ActionID { READ_PDF, INIT_PAGE, FINALIZE_PARMS, SYSTEM_IDENTIFICATION, ACTION_NUM};
@@ -62,8 +62,6 @@ public:
       Omr(Score*);
       Omr(const QString& path, Score*);
 
-      static char bitsSetTable[256];
-
       bool readPdf();
       int pagesInDocument() const;
       int numPages() const {
@@ -105,7 +103,7 @@ public:
       const QString& path() const {
             return _path;
             }
-      bool omrActions(int &ID, int page = 0);
+      bool omrActions(int ID, QProgressDialog* progress = 0);
 
       static Pattern* quartheadPattern;
       static Pattern* halfheadPattern;
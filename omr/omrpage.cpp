@@ -76,6 +76,27 @@ OmrPage::OmrPage(Omr* parent)
       {
       _omr = parent;
       cropL = cropR = cropT = cropB = 0;
+      _matcher = 0;
+      }
+
+OmrPage::~OmrPage()
+      {
+      delete _matcher;
+      }
+
+//---------------------------------------------------------
+//   matchPatterns
+//    score all patterns of pl on line y between x1 and x2,
+//    see PatternMatcher::search()
+//---------------------------------------------------------
+
+std::vector<PatternMatch> OmrPage::matchPatterns(const std::vector<Pattern*>& pl, int x1, int x2, int y, int step, double threshold)
+      {
+      if (!_matcher || !_matcher->isValid(_image, _ratio)) {
+            delete _matcher;
+            _matcher = new PatternMatcher(_image, _ratio);
+            }
+      return _matcher->search(pl, x1, x2, y, step, threshold);
       }
 
 //---------------------------------------------------------
@@ -486,25 +507,12 @@ OmrPattern OmrPage::searchPattern(const std::vector<Pattern*>& pl, int y, int x1
       OmrPattern p;
       p.sym = SymId::noSym;
       p.prob = 0.0;
-      for (Pattern* pattern : pl) {
-            double val = 0.0;
-            int xx = 0;
-            int hw = pattern->w();
-
-            for (int x = x1; x < (x2 - hw); ++x) {
-                  double val1 = pattern->match(&image(), x - pattern->base().x(), y - pattern->base().y());
-                  if (val1 > val) {
-                        val = val1;
-                        xx = x;
-                        }
+      for (const PatternMatch& m : matchPatterns(pl, x1, x2, y, 1, 0.0)) {
+            if (m.score > p.prob) {
+                  p.setRect(m.x, m.y, m.pattern->w(), m.pattern->h());
+                  p.sym = m.pattern->id();
+                  p.prob = m.score;
                   }
-
-            if (val > p.prob) {
-                  p.setRect(xx, y, pattern->w(), pattern->h());
-                  p.sym = pattern->id();
-                  p.prob = val;
-                  }
-            printf("Pattern found %d %f %d\n", int(pattern->id()), val, xx);
             }
       return p;
       }
@@ -1347,12 +1355,7 @@ int OmrPage::xproject(const uint* p, int wl)
       int x1 = cropL + w / 4;         // only look at part of page
       int x2 = x1 + w / 2;
       for (int x = cropL; x < x2; ++x) {
-            uint v = *p++;
-            run += Omr::bitsSetTable[v & 0xff]
-               + Omr::bitsSetTable[(v >> 8) & 0xff]
-               + Omr::bitsSetTable[(v >> 16) & 0xff]
-               + Omr::bitsSetTable[v >> 24];
-            }
+            run += qPopulationCount(quint32(*p++));
       return run;
       }
 
@@ -1573,18 +1576,11 @@ void OmrSystem::searchNotes(QList<OmrNote*>* noteList, int x1, int x2, int y, in
 
       QList<Peak> notePeaks;
       Pattern* pattern = Omr::quartheadPattern;
-      int hh = pattern->h();
-      int hw = pattern->w();
-      double val;
       int step_size = 2;
       int note_thresh = 50;
 
-      for (int x = x1; x < (x2 - hw); x += step_size) {
-            val = pattern->match(&_page->image(), x, y - hh / 2, _page->ratio());
-            if (val > note_thresh) {
-                  notePeaks.append(Peak(x, val, 0));
-                  }
-            }
+      for (const PatternMatch& m : _page->matchPatterns({ pattern }, x1, x2, y, step_size, note_thresh))
+            notePeaks.append(Peak(m.x, m.score, 0));
 
       int n = notePeaks.size();
       for (int i = 0; i < n; ++i) {
@@ -35,6 +35,8 @@ class Score;
 class XmlWriter;
 class XmlReader;
 class Pattern;
+class PatternMatcher;
+struct PatternMatch;
 class OmrPage;
 
 
@@ -200,6 +202,7 @@ class OmrPage {
 
       QList<QLine>  lines;
       QList<OmrSystem> _systems;
+      PatternMatcher* _matcher;           // built on first use for the current image
 
       void removeBorder();
       void crop();
@@ -218,6 +221,7 @@ class OmrPage {
 
    public:
       OmrPage(Omr* _parent);
+      ~OmrPage();
       void setImage(const QImage& i)     { _image = i; }
       const QImage& image() const        { return _image; }
       QImage& image()                    { return _image; }
@@ -240,6 +244,7 @@ class OmrPage {
       void readBarLines();
       float searchBarLines(int start_staff, int end_staff);
       void identifySystems();
+      std::vector<PatternMatch> matchPatterns(const std::vector<Pattern*>& pl, int x1, int x2, int y, int step, double threshold);
 
       const QList<OmrSystem>& systems() const { return _systems; }
       //QList<OmrSystem>& systems() { return _systems; }
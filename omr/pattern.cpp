@@ -32,6 +32,9 @@ namespace Ms {
 
 Pattern::Pattern()
       {
+      model = 0;
+      rows  = 0;
+      cols  = 0;
       }
 
 Pattern::~Pattern()
@@ -60,10 +63,16 @@ double Pattern::match(const Pattern* a) const
       int k = 0;
       const uchar* p1 = image()->bits();
       const uchar* p2 = a->image()->bits();
-      for (int i = 0; i < n; ++i) {
-            uchar v = (*(p1++)) ^ (*(p2++));
-            k += Omr::bitsSetTable[v];
+      // compare 64 bits at a time, the rest byte by byte
+      int i = 0;
+      for (; i + 8 <= n; i += 8) {
+            quint64 v1, v2;
+            memcpy(&v1, p1 + i, 8);
+            memcpy(&v2, p2 + i, 8);
+            k += qPopulationCount(v1 ^ v2);
             }
+      for (; i < n; ++i)
+            k += qPopulationCount(quint8(p1[i] ^ p2[i]));
       return 1.0 - (double(k) / (h() * w()));
       }
 
@@ -127,14 +136,14 @@ double Pattern::match(const QImage* img, int col, int row, double bg_parm) const
             p2++;
             uchar b  = (b1 >> shift) | (b2 << (7 - shift));
             uchar v = a ^ b;
-            k += Omr::bitsSetTable[v];
+            k += qPopulationCount(v);
             }
       uchar a = *p1++;
       uchar b1 = *p2;
       uchar b2 = *(p2 + 1) & (0xff << eshift);
       uchar b  = (b1 >> shift) | (b2 << (7 - shift));
       uchar v = a ^ b;
-      k += Omr::bitsSetTable[v];
+      k += qPopulationCount(v);
 #endif
       }
 
@@ -147,6 +156,9 @@ Pattern::Pattern(Score *s, SymId id, double spatium)
       {
       _score = s;
       _id = id;
+      model = 0;
+      rows  = 0;
+      cols  = 0;
 
       QFont f("Bravura");
       f.setPixelSize(lrint(spatium * 4));
@@ -188,6 +200,7 @@ Pattern::Pattern(Score *s, SymId id, double spatium)
 Pattern::Pattern(Score *s, QString name)
       {
       _score = s;
+      model  = 0;
 
       QFile f(QString(":/data/%1.dat").arg(name));
       if (!f.open(QIODevice::ReadOnly)) {
@@ -216,6 +229,9 @@ Pattern::Pattern(Score *s, QString name)
 
 Pattern::Pattern(QImage* img, int x, int y, int w, int h)
       {
+      model = 0;
+      rows  = 0;
+      cols  = 0;
       _image = img->copy(x, y, w, h);
       int ww = w % 32;
       if (ww == 0)
@@ -253,5 +269,139 @@ bool Pattern::dot(int x, int y) const
       const uint* p = (const uint*)_image.scanLine(y) + (x / 32);
       return (*p) & (0x1 << (x % 32));
       }
-}
 
+//---------------------------------------------------------
+//   PatternMatcher
+//---------------------------------------------------------
+
+PatternMatcher::PatternMatcher(const QImage& image, double bg_parm)
+   : _image(image)
+      {
+      _cacheKey = image.cacheKey();
+      _w        = image.width();
+      _h        = image.height();
+      _bg       = bg_parm;
+      _black.resize(size_t(_w) * _h);
+
+      // same test as Pattern::match()
+      QVector<QRgb> ct = image.colorTable();
+      QImage::Format format = image.format();
+      if ((format == QImage::Format_MonoLSB || format == QImage::Format_Mono) && ct.size() == 2) {
+            const uchar black[2] = { uchar(qGray(ct[0]) < 125), uchar(qGray(ct[1]) < 125) };
+            bool lsb = format == QImage::Format_MonoLSB;
+            for (int y = 0; y < _h; ++y) {
+                  const uchar* s = image.constScanLine(y);
+                  uchar* d       = &_black[size_t(y) * _w];
+                  for (int x = 0; x < _w; ++x) {
+                        int bit = lsb ? (s[x >> 3] >> (x & 7)) & 1 : (s[x >> 3] >> (~x & 7)) & 1;
+                        d[x] = black[bit];
+                        }
+                  }
+            }
+      else {
+            for (int y = 0; y < _h; ++y) {
+                  uchar* d = &_black[size_t(y) * _w];
+                  for (int x = 0; x < _w; ++x)
+                        d[x] = qGray(image.pixel(x, y)) < 125;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   weights
+//---------------------------------------------------------
+
+const PatternMatcher::Weights& PatternMatcher::weights(const Pattern* pattern)
+      {
+      auto i = _weights.find(pattern);
+      if (i != _weights.end())
+            return i.value();
+
+      Weights& wt = _weights[pattern];
+      double bg   = qBound(0.00001, _bg, 0.99999);
+      double log_bg_black = log(bg);
+      double log_bg_white = log(1.0 - bg);
+      int rows = pattern->rows;
+      int cols = pattern->cols;
+
+      wt.w.resize(rows * cols);
+      wt.base = 0.0;
+      for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                  double bs_scr    = qBound(0.00001, double(pattern->model[y][x]), 0.99999);
+                  double log_black = log(bs_scr) - log_bg_black;
+                  double log_white = log(1.0 - bs_scr) - log_bg_white;
+                  wt.w[y * cols + x] = log_black - log_white;
+                  wt.base += log_white;
+                  }
+            }
+      std::vector<double> sorted(wt.w);
+      std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+      wt.best.resize(sorted.size() + 1);
+      wt.best[0] = 0.0;
+      for (size_t n = 0; n < sorted.size(); ++n)
+            wt.best[n + 1] = wt.best[n] + sorted[n];
+      return wt;
+      }
+
+//---------------------------------------------------------
+//   search
+//    score every pattern of pl centered on line y at the
+//    positions x1, x1 + step, ... up to x2 minus the pattern
+//    width; return all candidates scoring above threshold,
+//    by pattern and position
+//---------------------------------------------------------
+
+std::vector<PatternMatch> PatternMatcher::search(const std::vector<Pattern*>& pl, int x1, int x2, int y, int step, double threshold)
+      {
+      std::vector<PatternMatch> ml;
+      for (const Pattern* pattern : pl) {
+            int rows = pattern->rows;
+            int cols = pattern->cols;
+            if (!pattern->model || rows <= 0 || cols <= 0)
+                  continue;
+            const Weights& wt = weights(pattern);
+            int row = y - rows / 2;
+
+            // vertical projection of the rows under the pattern,
+            // as prefix sums over x
+            bool inside = row >= 0 && row + rows <= _h;
+            std::vector<int> projection;
+            if (inside) {
+                  projection.assign(_w + 1, 0);
+                  for (int yy = row; yy < row + rows; ++yy) {
+                        const uchar* b = &_black[size_t(yy) * _w];
+                        for (int x = 0; x < _w; ++x)
+                              projection[x + 1] += b[x];
+                        }
+                  for (int x = 0; x < _w; ++x)
+                        projection[x + 1] += projection[x];
+                  }
+
+            for (int x = x1; x < (x2 - cols); x += step) {
+                  double val;
+                  if (!inside || x < 0 || x + cols > _w) {
+                        // clipped by the page border
+                        val = pattern->match(&_image, x, row, _bg);
+                        }
+                  else {
+                        int black = projection[x + cols] - projection[x];
+                        if (wt.base + wt.best[black] <= threshold)
+                              continue;
+                        val = wt.base;
+                        for (int yy = 0; yy < rows; ++yy) {
+                              const uchar* b  = &_black[size_t(row + yy) * _w + x];
+                              const double* w = &wt.w[yy * cols];
+                              for (int xx = 0; xx < cols; ++xx) {
+                                    if (b[xx])
+                                          val += w[xx];
+                                    }
+                              }
+                        }
+                  if (val > threshold)
+                        ml.push_back({ pattern, x, row, val });
+                  }
+            }
+      return ml;
+      }
+}
@@ -34,6 +34,8 @@ class Sym;
 //---------------------------------------------------------
 
 class Pattern {
+      friend class PatternMatcher;
+
    protected:
       QImage _image;
       SymId _id;
@@ -64,6 +66,52 @@ class Pattern {
       const QPoint& base() const { return _base; }
       void setBase(const QPoint& v) { _base = v; }
       };
+
+//---------------------------------------------------------
+//   PatternMatch
+//    a scored candidate position of a pattern
+//---------------------------------------------------------
+
+struct PatternMatch {
+      const Pattern* pattern;
+      int x;                  // top left corner in the page image
+      int y;
+      double score;
+      };
+
+//---------------------------------------------------------
+//   PatternMatcher
+//    scores patterns against a page image with the model
+//    of Pattern::match(img, col, row, bg_parm), which is
+//    a constant plus the weights of all black pixels.
+//    The black pixels are extracted once per page and
+//    the weights once per pattern; the number of black
+//    pixels under the pattern bounds its best possible
+//    score, so most positions are rejected from the
+//    vertical projection alone.
+//---------------------------------------------------------
+
+class PatternMatcher {
+      struct Weights {
+            std::vector<double> w;        // log score of black minus white, per pixel
+            double base;                  // score of an all white window
+            std::vector<double> best;     // best[n]: sum of the n largest weights
+            };
+
+      QImage _image;
+      qint64 _cacheKey;
+      int _w, _h;
+      double _bg;
+      std::vector<uchar> _black;          // one byte per pixel, 1 if black
+      QHash<const Pattern*, Weights> _weights;
+
+      const Weights& weights(const Pattern*);
+
+   public:
+      PatternMatcher(const QImage& image, double bg_parm);
+      bool isValid(const QImage& image, double bg_parm) const { return image.cacheKey() == _cacheKey && bg_parm == _bg; }
+      std::vector<PatternMatch> search(const std::vector<Pattern*>& pl, int x1, int x2, int y, int step, double threshold);
+      };
 }
 
 #endif
@@ -138,7 +138,7 @@ void OmrPage::radonTransform(ulong* projection, int w, int n, const QRect& r)
             int i = n;
             const uchar* p = (const uchar*)scanLine(r.y() + y);
             for (int x = 0; x < n; ++x)
-                  src->setCell(--i, y, Omr::bitsSetTable[*p++]);
+                  src->setCell(--i, y, qPopulationCount(quint8(*p++)));
             }
       radonProjection(src, dst, -1, projection);
 
@@ -146,7 +146,7 @@ void OmrPage::radonTransform(ulong* projection, int w, int n, const QRect& r)
       for (int y = 0; y < h; y++) {
             const uchar* p = (const uchar*)scanLine(r.y() + y);
             for (int x = 0; x < n; ++x)
-                  src->setCell(x, y, Omr::bitsSetTable[*p++]);
+                  src->setCell(x, y, qPopulationCount(quint8(*p++)));
             }
       radonProjection(src, dst, 1, projection);
 
@@ -23,25 +23,6 @@
 
 namespace Ms {
 
-char Omr::bitsSetTable[256];
-
-//---------------------------------------------------------
-//   initUtils
-//---------------------------------------------------------
-
-void Omr::initUtils()
-      {
-      static bool initialized = false;
-      if (initialized)
-            return;
-      initialized = true;
-      //
-      // populate the bitsSetTable
-      bitsSetTable[0] = 0;
-      for (int i = 1; i < 256; i++)
-            bitsSetTable[i] = (i & 1) + bitsSetTable[i/2];
-      }
-
 //---------------------------------------------------------
 //   mean
 //    Compute the arithmetic mean of a dataset using the
@@ -0,0 +1,195 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <algorithm>
+#include "audioprofiler.h"
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   AudioProfiler
+//---------------------------------------------------------
+
+AudioProfiler::AudioProfiler()
+      {
+      static_assert(!(RING_SIZE & (RING_SIZE - 1)), "RING_SIZE must be a power of two");
+      memset(&_current, 0, sizeof(_current));
+      _names[PERIOD]   = "period";
+      _names[MASTER]   = "master synthesizer";
+      _names[EFFECT_A] = "effect A";
+      _names[EFFECT_B] = "effect B";
+      _timer.start();
+      }
+
+//---------------------------------------------------------
+//   setProbeName
+//    gui thread
+//---------------------------------------------------------
+
+void AudioProfiler::setProbeName(int probe, const QString& name)
+      {
+      if (probe >= 0 && probe < MAX_PROBES)
+            _names[probe] = name;
+      }
+
+//---------------------------------------------------------
+//   beginPeriod
+//---------------------------------------------------------
+
+void AudioProfiler::beginPeriod(unsigned frames, float sampleRate)
+      {
+      if (_resetRequested.exchange(false)) {
+            _written        = 0;
+            _deadlineMisses = 0;
+            }
+      memset(&_current, 0, sizeof(_current));
+      _current.budget = sampleRate > 0.0 ? frames * 1000.0 / sampleRate : 0.0;
+      _periodStart    = now();
+      }
+
+//---------------------------------------------------------
+//   record
+//    add the time since start to probe, a probe may
+//    run several times in a period
+//---------------------------------------------------------
+
+void AudioProfiler::record(int probe, qint64 start)
+      {
+      if (probe < 0 || probe >= MAX_PROBES)
+            return;
+      _current.time[probe] += (now() - start) * 1e-6;
+      _current.ran |= 1u << probe;
+      }
+
+//---------------------------------------------------------
+//   endPeriod
+//---------------------------------------------------------
+
+void AudioProfiler::endPeriod()
+      {
+      record(PERIOD, _periodStart);
+      if (_current.budget > 0.0 && _current.time[PERIOD] > _current.budget)
+            ++_deadlineMisses;
+      _current.deadlineMisses = _deadlineMisses;
+      qint64 idx = _written.load(std::memory_order_relaxed);
+      _ring[idx & (RING_SIZE - 1)] = _current;
+      _written.store(idx + 1, std::memory_order_release);
+      }
+
+//---------------------------------------------------------
+//   percentile
+//    nearest rank of sorted values
+//---------------------------------------------------------
+
+static double percentile(const std::vector<float>& v, double p)
+      {
+      int idx = int(p * v.size());
+      return v[qMin(idx, int(v.size()) - 1)];
+      }
+
+//---------------------------------------------------------
+//   stats
+//---------------------------------------------------------
+
+AudioProfileStats AudioProfiler::stats() const
+      {
+      AudioProfileStats st;
+      qint64 written = _written.load(std::memory_order_acquire);
+      qint64 first   = qMax(qint64(0), written - RING_SIZE);
+      std::vector<Period> periods;
+      periods.reserve(written - first);
+      for (qint64 i = first; i < written; ++i)
+            periods.push_back(_ring[i & (RING_SIZE - 1)]);
+
+      // the audio thread may have reused the slots of the oldest
+      // periods while they were copied, up to the one it writes now
+      qint64 after = _written.load(std::memory_order_acquire);
+      if (after < written)                // reset while copying
+            return st;
+      qint64 valid = qMax(first, after - RING_SIZE + 1);
+      periods.erase(periods.begin(), periods.begin() + (valid - first));
+
+      // the counters are taken from the newest period, which is
+      // the one published by written
+      st.periods = int(periods.size());
+      if (periods.empty()) {
+            st.totalPeriods = after;
+            return st;
+            }
+      st.totalPeriods   = written;
+      st.deadlineMisses = periods.back().deadlineMisses;
+      st.budget         = periods.back().budget;
+
+      double load   = 0.0;
+      double voices = 0.0;
+      for (const Period& p : periods) {
+            if (p.budget > 0.0)
+                  load += p.time[PERIOD] / p.budget;
+            voices += p.voices;
+            st.maxVoices = qMax(st.maxVoices, p.voices);
+            }
+      st.load       = load / periods.size();
+      st.meanVoices = voices / periods.size();
+
+      std::vector<float> times;
+      times.reserve(periods.size());
+      for (int probe = 0; probe < MAX_PROBES; ++probe) {
+            times.clear();
+            double sum = 0.0;
+            for (const Period& p : periods) {
+                  if (p.ran & (1u << probe)) {
+                        times.push_back(p.time[probe]);
+                        sum += p.time[probe];
+                        }
+                  }
+            if (times.empty())
+                  continue;
+            std::sort(times.begin(), times.end());
+            AudioProfileStats::Probe pr;
+            pr.name    = _names[probe].isEmpty() ? QString("probe %1").arg(probe) : _names[probe];
+            pr.periods = int(times.size());
+            pr.mean    = sum / times.size();
+            pr.p50     = percentile(times, 0.50);
+            pr.p95     = percentile(times, 0.95);
+            pr.p99     = percentile(times, 0.99);
+            pr.worst   = times.back();
+            st.probes.append(pr);
+            }
+      return st;
+      }
+
+//---------------------------------------------------------
+//   toString
+//---------------------------------------------------------
+
+QString AudioProfileStats::toString() const
+      {
+      QString s;
+      s += QString("periods: %1 of %2, budget %3 ms, load %4 %, deadline misses %5\n")
+         .arg(periods).arg(totalPeriods).arg(budget, 0, 'f', 2).arg(load * 100.0, 0, 'f', 1).arg(deadlineMisses);
+      s += QString("voices: mean %1, max %2\n").arg(meanVoices, 0, 'f', 1).arg(maxVoices);
+      s += QString("%1 %2 %3 %4 %5 %6  (ms)\n")
+         .arg("probe", -24).arg("mean", 8).arg("p50", 8).arg("p95", 8).arg("p99", 8).arg("worst", 8);
+      for (const Probe& p : probes) {
+            s += QString("%1 %2 %3 %4 %5 %6\n")
+               .arg(p.name.left(24), -24)
+               .arg(p.mean, 8, 'f', 3)
+               .arg(p.p50, 8, 'f', 3)
+               .arg(p.p95, 8, 'f', 3)
+               .arg(p.p99, 8, 'f', 3)
+               .arg(p.worst, 8, 'f', 3);
+            }
+      return s;
+      }
+
+}
+
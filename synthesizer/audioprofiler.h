@@ -0,0 +1,151 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2017 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __AUDIOPROFILER_H__
+#define __AUDIOPROFILER_H__
+
+#include <atomic>
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   AudioProfileStats
+//    statistics over the periods kept by an AudioProfiler,
+//    all times in milliseconds
+//---------------------------------------------------------
+
+struct AudioProfileStats {
+      struct Probe {
+            QString name;
+            int periods  { 0 };           // periods the probe ran in
+            double mean  { 0.0 };
+            double p50   { 0.0 };
+            double p95   { 0.0 };
+            double p99   { 0.0 };
+            double worst { 0.0 };
+            };
+      QList<Probe> probes;
+      int periods           { 0 };      // periods the statistics are computed from
+      qint64 totalPeriods   { 0 };      // periods since reset up to the newest one copied
+      qint64 deadlineMisses { 0 };      // of those the periods which took longer than their audio
+      double budget         { 0.0 };    // audio length of the last period
+      double load           { 0.0 };    // mean fraction of the budget used
+      double meanVoices     { 0.0 };
+      int maxVoices         { 0 };
+
+      QString toString() const;
+      };
+
+//---------------------------------------------------------
+//   AudioProfiler
+//    per period timings of the audio thread
+//    - only the audio thread records; a finished period is
+//      stored in a ring buffer and published by advancing
+//      an atomic counter, there are no locks and no
+//      allocations
+//    - stats() may be called from any other thread, periods
+//      overwritten while they are copied are dropped
+//---------------------------------------------------------
+
+class AudioProfiler {
+   public:
+      enum Probe {
+            PERIOD,           // the whole period, Seq::process() or the offline renderer
+            MASTER,           // MasterSynthesizer::process()
+            EFFECT_A,
+            EFFECT_B,
+            SYNTHESIZER       // first synthesizer, one probe per synthesizer follows
+            };
+      static const int MAX_PROBES = 12;
+      static const int RING_SIZE  = 2048;       // periods, must be a power of two
+
+   private:
+      struct Period {
+            float time[MAX_PROBES];
+            unsigned ran;                 // bit mask of probes which ran in this period
+            float budget;
+            int voices;
+            qint64 deadlineMisses;        // periods up to this one which missed their deadline
+            };
+
+      Period _ring[RING_SIZE];
+      Period _current;                    // audio thread only
+      qint64 _periodStart { 0 };
+      qint64 _deadlineMisses { 0 };       // audio thread only, published with each period
+      QElapsedTimer _timer;
+      QString _names[MAX_PROBES];
+
+      std::atomic<bool> _enabled          { false };
+      std::atomic<bool> _resetRequested   { false };
+      std::atomic<qint64> _written        { 0 };    // periods since reset
+
+   public:
+      AudioProfiler();
+
+      bool enabled() const                { return _enabled; }
+      void setEnabled(bool val)           { _enabled = val; }
+      void reset()                        { _resetRequested = true; }
+      void setProbeName(int probe, const QString& name);
+
+      // audio thread
+      qint64 now() const                  { return _timer.nsecsElapsed(); }
+      void beginPeriod(unsigned frames, float sampleRate);
+      void endPeriod();
+      void record(int probe, qint64 start);
+      void setVoices(int n)               { _current.voices = qMax(_current.voices, n); }
+
+      AudioProfileStats stats() const;
+      };
+
+//---------------------------------------------------------
+//   AudioProfileScope
+//    record the lifetime of the scope for a probe,
+//    does nothing without a profiler
+//---------------------------------------------------------
+
+class AudioProfileScope {
+      AudioProfiler* _profiler;
+      int _probe;
+      qint64 _start;
+
+   public:
+      AudioProfileScope(AudioProfiler* p, int probe)
+         : _profiler(p), _probe(probe), _start(p ? p->now() : 0) {}
+      ~AudioProfileScope() {
+            if (_profiler)
+                  _profiler->record(_probe, _start);
+            }
+      };
+
+//---------------------------------------------------------
+//   AudioProfilePeriod
+//    record one period for the lifetime of the scope,
+//    does nothing without a profiler
+//---------------------------------------------------------
+
+class AudioProfilePeriod {
+      AudioProfiler* _profiler;
+
+   public:
+      AudioProfilePeriod(AudioProfiler* p, unsigned frames, float sampleRate) : _profiler(p) {
+            if (_profiler)
+                  _profiler->beginPeriod(frames, sampleRate);
+            }
+      ~AudioProfilePeriod() {
+            if (_profiler)
+                  _profiler->endPeriod();
+            }
+      };
+
+}
+#endif
+
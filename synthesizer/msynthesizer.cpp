@@ -173,6 +173,7 @@ Synthesizer* MasterSynthesizer::synthesizer(const QString& name)
 
 void MasterSynthesizer::registerSynthesizer(Synthesizer* s)
       {
+      _profiler.setProbeName(AudioProfiler::SYNTHESIZER + int(_synthesizer.size()), s->name());
       _synthesizer.push_back(s);
       }
 
@@ -200,6 +201,7 @@ void MasterSynthesizer::setEffect(int ab, int idx)
             sleep(1);
       _effect[ab] = _effectList[ab][idx];
       lock2 = false;
+      _profiler.setProbeName(AudioProfiler::EFFECT_A + ab, QString("effect %1 (%2)").arg(ab ? 'B' : 'A').arg(_effect[ab]->name()));
       }
 
 //---------------------------------------------------------
@@ -246,22 +248,33 @@ void MasterSynthesizer::process(unsigned n, float* p)
       // avoid overflow
       if (n > MAX_BUFFERSIZE / 2)
             return;
+      AudioProfiler* prof = _profiler.enabled() ? &_profiler : nullptr;
+      AudioProfileScope masterScope(prof, AudioProfiler::MASTER);
+      int voices = 0;
+      int idx    = 0;
       for (Synthesizer* s : _synthesizer) {
-            if (s->active())
+            if (s->active()) {
+                  AudioProfileScope scope(prof, AudioProfiler::SYNTHESIZER + idx);
                   s->process(n, p, effect1Buffer, effect2Buffer);
+                  if (prof)
+                        voices += s->voiceCount();
+                  }
+            ++idx;
             }
+      if (prof)
+            prof->setVoices(voices);
 
       if (_effect[0] && _effect[1]) {
             memset(effect1Buffer, 0, n * sizeof(float) * 2);
-            _effect[0]->process(n, p, effect1Buffer);
-            _effect[1]->process(n, effect1Buffer, p);
+            processEffect(prof, 0, n, p, effect1Buffer);
+            processEffect(prof, 1, n, effect1Buffer, p);
             }
       else if (_effect[0] || _effect[1]) {
             memcpy(effect1Buffer, p, n * sizeof(float) * 2);
             if (_effect[0])
-                  _effect[0]->process(n, effect1Buffer, p);
+                  processEffect(prof, 0, n, effect1Buffer, p);
             else
-                  _effect[1]->process(n, effect1Buffer, p);
+                  processEffect(prof, 1, n, effect1Buffer, p);
             }
       float g = _gain * _boost;
       for (unsigned i = 0; i < n * 2; ++i)
@@ -269,6 +282,16 @@ void MasterSynthesizer::process(unsigned n, float* p)
       lock1 = false;
       }
 
+//---------------------------------------------------------
+//   processEffect
+//---------------------------------------------------------
+
+void MasterSynthesizer::processEffect(AudioProfiler* prof, int ab, unsigned n, float* in, float* out)
+      {
+      AudioProfileScope scope(prof, AudioProfiler::EFFECT_A + ab);
+      _effect[ab]->process(n, in, out);
+      }
+
 //---------------------------------------------------------
 //   indexOfEffect
 //---------------------------------------------------------
@@ -15,6 +15,7 @@
 
 #include <atomic>
 #include "effects/effect.h"
+#include "audioprofiler.h"
 #include "libmscore/synthesizerstate.h"
 
 namespace Ms {
@@ -52,7 +53,9 @@ class MasterSynthesizer : public QObject {
 
       float effect1Buffer[MAX_BUFFERSIZE];
       float effect2Buffer[MAX_BUFFERSIZE];
+      AudioProfiler _profiler;
       int indexOfEffect(int ab, const QString& name);
+      void processEffect(AudioProfiler*, int ab, unsigned n, float* in, float* out);
 
    public slots:
       void sfChanged() { emit soundFontChanged(); }
@@ -102,6 +105,8 @@ class MasterSynthesizer : public QObject {
       float gain() const     { return _gain; }
       float boost() const    { return _boost; }
       void setBoost(float v) { _boost = v; }
+
+      AudioProfiler* profiler() { return &_profiler; }
       };
 
 }
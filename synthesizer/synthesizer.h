@@ -52,6 +52,7 @@ class Synthesizer {
 
       virtual void process(unsigned, float*, float*, float*) = 0;
       virtual void play(const PlayEvent&) = 0;
+      virtual int voiceCount() const { return 0; }     // sounding voices, called in realtime thread
 
       virtual const QList<MidiPatch*>& getPatchInfo() const = 0;
 
@@ -46,6 +46,7 @@
 #include "qzipwriter_p.h"
 
 #include <zlib.h>
+#include <QtConcurrent/QtConcurrentMap>
 
 #if defined(Q_OS_WIN) or defined(Q_OS_ANDROID)
 #  undef S_IFREG
@@ -441,10 +442,14 @@ public:
     }
 
     void scanFiles();
+    int indexOf(const QString &fileName) const;
+    qint64 dataStart(const FileHeader &header) const;
 
     MQZipReader::Status status;
 };
 
+class MQZipEntryWriter;
+
 class MQZipWriterPrivate : public MQZipPrivate
 {
 public:
@@ -452,19 +457,235 @@ public:
         : MQZipPrivate(device, ownDev),
         status(MQZipWriter::NoError),
         permissions(QFile::ReadOwner | QFile::WriteOwner),
-        compressionPolicy(MQZipWriter::AlwaysCompress)
+        compressionPolicy(MQZipWriter::AlwaysCompress),
+        openEntry(0)
     {
     }
 
     MQZipWriter::Status status;
     QFile::Permissions permissions;
     MQZipWriter::CompressionPolicy compressionPolicy;
+    MQZipEntryWriter *openEntry;    // entry currently streamed by openFile()
 
     enum EntryType { Directory, File, Symlink };
 
+    bool prepareDevice();
+    void closeOpenEntry();
+    FileHeader entryHeader(EntryType type, const QString &fileName) const;
+    static QByteArray compressData(const QByteArray &contents);
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    void writeEntry(EntryType type, const QString &fileName, const QByteArray &contents, const QByteArray &data, bool compressed);
+};
+
+/*
+    Sequential device inflating one archive entry while it is read.
+    Only a window of the compressed data is held in memory.
+*/
+class MQZipEntryReader : public QIODevice
+{
+public:
+    MQZipEntryReader(QIODevice *archive, qint64 start, qint64 compressedSize, qint64 uncompressedSize, int method)
+        : archive(archive), inPos(start), inLeft(compressedSize), outLeft(uncompressedSize),
+          method(method), finished(false)
+    {
+        memset(&stream, 0, sizeof(stream));
+        if (method == 8 && inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+            finished = true;
+        open(QIODevice::ReadOnly);
+    }
+
+    ~MQZipEntryReader()
+    {
+        if (method == 8)
+            inflateEnd(&stream);
+    }
+
+    bool isSequential() const { return true; }
+    qint64 bytesAvailable() const { return (finished ? 0 : outLeft) + QIODevice::bytesAvailable(); }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+    qint64 writeData(const char *, qint64) { return -1; }
+
+private:
+    QIODevice *archive;
+    qint64 inPos;       // position of the next compressed byte in the archive
+    qint64 inLeft;      // compressed bytes not yet read from the archive
+    qint64 outLeft;     // uncompressed bytes not yet returned
+    int method;
+    bool finished;
+    z_stream stream;
+    QByteArray inBuffer;
+};
+
+qint64 MQZipEntryReader::readData(char *data, qint64 maxSize)
+{
+    if (finished || maxSize <= 0)
+        return 0;
+    if (method == 0) {
+        // stored
+        archive->seek(inPos);
+        qint64 n = archive->read(data, qMin(maxSize, qMin(inLeft, outLeft)));
+        if (n <= 0) {
+            finished = true;
+            return n < 0 ? -1 : 0;
+        }
+        inPos += n;
+        inLeft -= n;
+        outLeft -= n;
+        if (inLeft == 0 || outLeft == 0)
+            finished = true;
+        return n;
+    }
+
+    stream.next_out = (Bytef *)data;
+    stream.avail_out = (uInt)qMin(maxSize, qint64(0x7fffffff));
+    while (stream.avail_out > 0) {
+        if (stream.avail_in == 0) {
+            if (inLeft == 0) {
+                qWarning("QZip: Z_DATA_ERROR: Input data is truncated");
+                finished = true;
+                break;
+            }
+            archive->seek(inPos);
+            inBuffer = archive->read(qMin(inLeft, qint64(64 * 1024)));
+            if (inBuffer.isEmpty()) {
+                qWarning("QZip: Failed to read compressed data");
+                finished = true;
+                break;
+            }
+            inPos += inBuffer.size();
+            inLeft -= inBuffer.size();
+            stream.next_in = (Bytef *)inBuffer.data();
+            stream.avail_in = inBuffer.size();
+        }
+        int res = inflate(&stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END) {
+            finished = true;
+            break;
+        }
+        if (res != Z_OK) {
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            finished = true;
+            break;
+        }
+    }
+    qint64 n = qMin(maxSize, qint64(0x7fffffff)) - stream.avail_out;
+    outLeft = qMax(qint64(0), outLeft - n);
+    return n;
+}
+
+/*
+    Sequential device deflating one archive entry while it is written.
+    The local header is written first and patched with the checksum
+    and sizes when the device is closed.
+*/
+class MQZipEntryWriter : public QIODevice
+{
+public:
+    MQZipEntryWriter(MQZipWriterPrivate *zip, int index, bool compress)
+        : zip(zip), index(index), compress(compress), crc(::crc32(0, 0, 0)), size(0), compressedSize(0)
+    {
+        memset(&stream, 0, sizeof(stream));
+        if (compress && deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file");
+            this->compress = false;
+        }
+        open(QIODevice::WriteOnly);
+    }
+
+    ~MQZipEntryWriter()
+    {
+        close();
+    }
+
+    bool isSequential() const { return true; }
+    void close();
+
+protected:
+    qint64 readData(char *, qint64) { return -1; }
+    qint64 writeData(const char *data, qint64 len);
+
+private:
+    bool deflateInput(int flush);
+
+    MQZipWriterPrivate *zip;
+    int index;          // index of the entry in zip->fileHeaders
+    bool compress;
+    uint crc;
+    qint64 size;
+    qint64 compressedSize;
+    z_stream stream;
 };
 
+bool MQZipEntryWriter::deflateInput(int flush)
+{
+    char out[64 * 1024];
+    int res;
+    do {
+        stream.next_out = (Bytef *)out;
+        stream.avail_out = sizeof(out);
+        res = deflate(&stream, flush);
+        if (res == Z_STREAM_ERROR)
+            return false;
+        qint64 n = sizeof(out) - stream.avail_out;
+        if (n && zip->device->write(out, n) != n)
+            return false;
+        compressedSize += n;
+    } while (stream.avail_out == 0 || (flush == Z_FINISH && res != Z_STREAM_END));
+    return true;
+}
+
+qint64 MQZipEntryWriter::writeData(const char *data, qint64 len)
+{
+    if (!zip)
+        return -1;
+    crc = ::crc32(crc, (const uchar *)data, len);
+    size += len;
+    if (!compress) {
+        qint64 n = zip->device->write(data, len);
+        if (n > 0)
+            compressedSize += n;
+        return n;
+    }
+    stream.next_in = (Bytef *)data;
+    stream.avail_in = (uInt)len;
+    if (!deflateInput(Z_NO_FLUSH)) {
+        zip->status = MQZipWriter::FileWriteError;
+        return -1;
+    }
+    return len;
+}
+
+void MQZipEntryWriter::close()
+{
+    if (!isOpen())
+        return;
+    QIODevice::close();
+    if (!zip)
+        return;
+    if (compress) {
+        stream.next_in = 0;
+        stream.avail_in = 0;
+        if (!deflateInput(Z_FINISH))
+            zip->status = MQZipWriter::FileWriteError;
+        deflateEnd(&stream);
+    }
+
+    FileHeader &header = zip->fileHeaders[index];
+    writeUInt(header.h.crc_32, crc);
+    writeUInt(header.h.compressed_size, compressedSize);
+    writeUInt(header.h.uncompressed_size, size);
+
+    LocalFileHeader h = header.h.toLocalHeader();
+    zip->start_of_directory = zip->device->pos();
+    zip->device->seek(readUInt(header.h.offset_local_header));
+    zip->device->write((const char *)&h, sizeof(LocalFileHeader));
+    zip->device->seek(zip->start_of_directory);
+    zip->dirtyFileTree = true;
+    zip->openEntry = 0;
+}
+
 LocalFileHeader MCentralFileHeader::toLocalHeader() const
 {
     LocalFileHeader h;
@@ -481,6 +702,25 @@ LocalFileHeader MCentralFileHeader::toLocalHeader() const
     return h;
 }
 
+int MQZipReaderPrivate::indexOf(const QString &fileName) const
+{
+    for (int i = 0; i < fileHeaders.size(); ++i) {
+        if (QString::fromUtf8(fileHeaders.at(i).file_name) == fileName)
+            return i;
+    }
+    return -1;
+}
+
+qint64 MQZipReaderPrivate::dataStart(const FileHeader &header) const
+{
+    int start = readUInt(header.h.offset_local_header);
+    device->seek(start);
+    LocalFileHeader lh;
+    device->read((char *)&lh, sizeof(LocalFileHeader));
+    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    return start + sizeof(LocalFileHeader) + skip;
+}
+
 void MQZipReaderPrivate::scanFiles()
 {
     if (!dirtyFileTree)
@@ -570,69 +810,31 @@ void MQZipReaderPrivate::scanFiles()
     }
 }
 
-void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+bool MQZipWriterPrivate::prepareDevice()
 {
-#ifndef NDEBUG
-    static const char *entryTypes[] = {
-        "directory",
-        "file     ",
-        "symlink  " };
-    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
-#endif
-
+    closeOpenEntry();
     if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
         status = MQZipWriter::FileOpenError;
-        return;
+        return false;
     }
     device->seek(start_of_directory);
+    return true;
+}
 
-    // don't compress small files
-    MQZipWriter::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == MQZipWriter::AutoCompress) {
-        if (contents.length() < 64)
-            compression = MQZipWriter::NeverCompress;
-        else
-            compression = MQZipWriter::AlwaysCompress;
-    }
+void MQZipWriterPrivate::closeOpenEntry()
+{
+    if (openEntry)
+        openEntry->close();
+}
 
+FileHeader MQZipWriterPrivate::entryHeader(EntryType type, const QString &fileName) const
+{
     FileHeader header;
     memset(&header.h, 0, sizeof(MCentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, 0x14);
-    writeUInt(header.h.uncompressed_size, contents.length());
     writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == MQZipWriter::AlwaysCompress) {
-        writeUShort(header.h.compression_method, 8);
-
-       ulong len = contents.length();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.length());
-    uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
-    writeUInt(header.h.crc_32, crc_32);
 
     header.file_name = fileName.toUtf8();
     if (header.file_name.size() > 0xffff) {
@@ -653,7 +855,82 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     }
     writeUInt(header.h.external_file_attributes, mode << 16);
     writeUInt(header.h.offset_local_header, start_of_directory);
+    return header;
+}
+
+/*
+    Deflate \a contents. This does not touch the archive and may run
+    concurrently for several entries.
+*/
+QByteArray MQZipWriterPrivate::compressData(const QByteArray &contents)
+{
+    QByteArray data;
+    ulong len = contents.length();
+    // shamelessly copied form zlib
+    len += (len >> 12) + (len >> 14) + 11;
+    int res;
+    do {
+        data.resize(len);
+        res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
+
+        switch (res) {
+        case Z_OK:
+            data.resize(len);
+            break;
+        case Z_MEM_ERROR:
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+            data.resize(0);
+            break;
+        case Z_BUF_ERROR:
+            len *= 2;
+            break;
+        }
+    } while (res == Z_BUF_ERROR);
+    return data;
+}
+
+void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+{
+#ifndef NDEBUG
+    static const char *entryTypes[] = {
+        "directory",
+        "file     ",
+        "symlink  " };
+    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
+#endif
+
+    // don't compress small files
+    MQZipWriter::CompressionPolicy compression = compressionPolicy;
+    if (compressionPolicy == MQZipWriter::AutoCompress) {
+        if (contents.length() < 64)
+            compression = MQZipWriter::NeverCompress;
+        else
+            compression = MQZipWriter::AlwaysCompress;
+    }
+
+    if (compression == MQZipWriter::AlwaysCompress)
+        writeEntry(type, fileName, contents, compressData(contents), true);
+    else
+        writeEntry(type, fileName, contents, contents, false);
+}
+
+/*
+    Append an entry with uncompressed \a contents, stored as \a data.
+*/
+void MQZipWriterPrivate::writeEntry(EntryType type, const QString &fileName, const QByteArray &contents, const QByteArray &data, bool compressed)
+{
+    if (!prepareDevice())
+        return;
 
+    FileHeader header = entryHeader(type, fileName);
+    writeUInt(header.h.uncompressed_size, contents.length());
+    if (compressed)
+        writeUShort(header.h.compression_method, 8);
+// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
+    writeUInt(header.h.compressed_size, data.length());
+    uint crc_32 = ::crc32(0, 0, 0);
+    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
+    writeUInt(header.h.crc_32, crc_32);
 
     fileHeaders.append(header);
 
@@ -850,28 +1127,19 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
 QByteArray MQZipReader::fileData(const QString &fileName) const
 {
     d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
+    int i = d->indexOf(fileName);
+    if (i == -1)
         return QByteArray();
 
     FileHeader header = d->fileHeaders.at(i);
 
     int compressed_size = readUInt(header.h.compressed_size);
     int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
+    //qDebug("uncompressing file %d: local header at %d", i, readUInt(header.h.offset_local_header));
 
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
+    d->device->seek(d->dataStart(header));
 
-    int compression_method = readUShort(lh.compression_method);
+    int compression_method = readUShort(header.h.compression_method);
     //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
 
     //qDebug("file at %lld", d->device->pos());
@@ -914,6 +1182,30 @@ QByteArray MQZipReader::fileData(const QString &fileName) const
     return QByteArray();
 }
 
+/*!
+    Return a sequential device that reads the uncompressed contents of
+    \a fileName while inflating it from the archive, or 0 if the archive
+    does not contain the file.
+    The caller takes ownership of the device, which must not outlive
+    the reader.
+*/
+QIODevice *MQZipReader::openFile(const QString &fileName) const
+{
+    d->scanFiles();
+    int i = d->indexOf(fileName);
+    if (i == -1)
+        return 0;
+
+    const FileHeader &header = d->fileHeaders.at(i);
+    int compression_method = readUShort(header.h.compression_method);
+    if (compression_method != 0 && compression_method != 8) {
+        qWarning() << "QZip: Unknown compression method";
+        return 0;
+    }
+    return new MQZipEntryReader(d->device, d->dataStart(header),
+       readUInt(header.h.compressed_size), readUInt(header.h.uncompressed_size), compression_method);
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
@@ -1202,6 +1494,55 @@ void MQZipWriter::addFile(const QString &fileName, QIODevice *device)
         device->close();
 }
 
+/*!
+    Add several files to the archive. The contents are compressed
+    concurrently and then written in the order given.
+*/
+void MQZipWriter::addFiles(const QList<QPair<QString, QByteArray> > &files)
+{
+    QList<QByteArray> contents;
+    for (const QPair<QString, QByteArray> &file : files)
+        contents.append(file.second);
+
+    bool compress = d->compressionPolicy != NeverCompress;
+    QList<QByteArray> data;
+    if (compress)
+        data = QtConcurrent::blockingMapped(contents, MQZipWriterPrivate::compressData);
+
+    for (int i = 0; i < files.size(); ++i) {
+        bool c = compress && (d->compressionPolicy == AlwaysCompress || contents.at(i).length() >= 64);
+        d->writeEntry(MQZipWriterPrivate::File, files.at(i).first, contents.at(i), c ? data.at(i) : contents.at(i), c);
+    }
+}
+
+/*!
+    Start a file named \a fileName in the archive and return a sequential
+    device which compresses everything written to it straight into the
+    archive. The entry is finished when the device is closed or deleted,
+    which must happen before any other entry is added.
+    The caller takes ownership of the device.
+*/
+QIODevice *MQZipWriter::openFile(const QString &fileName)
+{
+    if (!d->prepareDevice())
+        return 0;
+
+    FileHeader header = d->entryHeader(MQZipWriterPrivate::File, fileName);
+    bool compress = d->compressionPolicy != NeverCompress;
+    if (compress)
+        writeUShort(header.h.compression_method, 8);
+    d->fileHeaders.append(header);
+
+    LocalFileHeader h = header.h.toLocalHeader();
+    d->device->write((const char *)&h, sizeof(LocalFileHeader));
+    d->device->write(header.file_name);
+    d->start_of_directory = d->device->pos();
+    d->dirtyFileTree = true;
+
+    d->openEntry = new MQZipEntryWriter(d, d->fileHeaders.size() - 1, compress);
+    return d->openEntry;
+}
+
 /*!
     Create a new directory in the archive with the specified \a dirName and
     the \a permissions;
@@ -1230,6 +1571,7 @@ void MQZipWriter::addSymLink(const QString &fileName, const QString &destination
 */
 void MQZipWriter::close()
 {
+    d->closeOpenEntry();
     if (!(d->device->openMode() & QIODevice::WriteOnly)) {
         d->device->close();
         return;
@@ -101,6 +101,10 @@ public:
 
     void addFile(const QString &fileName, QIODevice *device);
 
+    void addFiles(const QList<QPair<QString, QByteArray> > &files);
+
+    QIODevice *openFile(const QString &fileName);
+
     void addDirectory(const QString &dirName);
 
     void addSymLink(const QString &fileName, const QString &destination);
@@ -219,6 +219,7 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
             return;
       Voice* v = activeVoices;
       Voice* pv = 0;
+      int n = 0;
       while (v) {
             v->process(frames, p);
             if (v->isOff()) {
@@ -228,10 +229,13 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
                         activeVoices = v->next();
                   freeVoices.push(v);
                   }
-            else
+            else {
                   pv = v;
+                  ++n;
+                  }
             v = v->next();
             }
+      soundingVoices = n;
       }
 
 //---------------------------------------------------------
@@ -80,6 +80,7 @@ class Zerberus : public Ms::Synthesizer {
       int allocatedVoices = 0;
       VoiceFifo freeVoices;
       Voice* activeVoices = 0;
+      int soundingVoices = 0;       // active voices after the last process()
       int _loadProgress = 0;
       bool _loadWasCanceled = false;
 
@@ -94,6 +95,7 @@ class Zerberus : public Ms::Synthesizer {
 
       virtual void process(unsigned frames, float*, float*, float*);
       virtual void play(const Ms::PlayEvent& event);
+      virtual int voiceCount() const { return soundingVoices; }
 
       bool loadInstrument(const QString&);
 